@@ -20,6 +20,117 @@
 //   mem_edit_2.DrawContents(this, sizeof(*this), (size_t)this);
 //   ImGui::End();
 //
+// Usage:
+//   // When viewing a device bus or emulator memory where reads may have side-effects, declare regions with an access policy:
+//   mem_edit.AddRegion(0x0000, 0x8000, MemoryEditor::RegionPolicy_Cacheable);        // ROM: read once
+//   mem_edit.AddRegion(0xFF00, 0xFF40, MemoryEditor::RegionPolicy_Volatile, 10.0f);  // Status registers: re-read 10 times per second
+//   mem_edit.AddRegion(0xFF40, 0xFF48, MemoryEditor::RegionPolicy_NeverRead);        // FIFO/clear-on-read registers: only read on Refresh()
+//
+// Usage:
+//   // Linux data sources and settings (process, shared memory and file sources, WriteWatch, OptSafeReads) include POSIX system headers, and are opt-in:
+//   #define IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES
+//   #include "imgui_memory_editor.h"
+//
+// Usage:
+//   // View memory of another process (Linux, with IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES). With a RefreshRate, it is re-read at that rate and changed pages are found by comparing hashes.
+//   static MemoryEditorProcessSource process_source;
+//   process_source.OptSoftDirty = true;    // optional: only re-read written pages. resets soft-dirty bits of the whole process on each refresh!
+//   process_source.Open(pid, heap_addr, heap_size);
+//   mem_edit.RefreshRate = 10.0f;
+//   mem_edit.DrawWindow("Process Heap", &process_source, heap_addr);
+//
+// Usage:
+//   // Opt-in write detection for a large buffer of this process (Linux, with IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES). Watched pages are write-protected and only pages written since the last refresh are re-read.
+//   // Only use on heap/static memory which is never written by system calls (e.g. read() into a watched page would fail with EFAULT).
+//   static MemoryEditorWriteWatch write_watch;
+//   write_watch.Watch(arena_data, arena_size);
+//   mem_edit.WriteWatch = &write_watch;
+//   mem_edit.DrawWindow("Arena", arena_data, arena_size);
+//
+// Usage:
+//   // Inspect an arbitrary pointer of this process without risking a crash (Linux, with IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES): unreadable pages are displayed as "??".
+//   mem_edit.OptSafeReads = true;
+//   mem_edit.DrawContents((void*)ptr, 0x1000, (size_t)ptr);
+//
+// Usage:
+//   // Inspect a shared memory segment (Linux with IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES, read-only by default). Link with -lrt on glibc < 2.34.
+//   static MemoryEditorSharedMemorySource shm_source;
+//   shm_source.OpenPosix("/my_ring");                  // or shm_source.OpenSysV(shmid);
+//   shm_source.SeqlockOffset = 0;                      // optional: producer increments a 32-bit counter at this offset before and after each write
+//   mem_edit.DrawWindow("Ring", &shm_source);
+//
+// Usage:
+//   // Share one worker pool between all editors, to cap the total number of threads used by background jobs:
+//   static MemoryEditorJobSystem job_system;
+//   job_system.Start(2);
+//   mem_edit_1.JobSystem = mem_edit_2.JobSystem = &job_system;
+//   // Without JobSystem (or with 0 threads) jobs are time-sliced inside DrawContents(), JobTimeBudget milliseconds per frame.
+//
+//   // Several views of the same data (code, heap, stack...) can share one cache, regions, highlight layers and undo history:
+//   static MemoryEditor::SharedState shared;
+//   mem_edit_1.Shared = mem_edit_2.Shared = mem_edit_3.Shared = &shared;
+//   shared.DataBase = image;                                      // views may show parts of it: offsets of regions/highlights are from 'image'
+//   shared.AddHighlight(0x100, 0x180, IM_COL32(255, 0, 0, 60));
+//   mem_edit_1.DrawWindow("Image", image, image_size);
+//   mem_edit_2.DrawWindow("Code", image + code_off, code_size, code_off);
+//   mem_edit_3.DrawWindow("Stack", stack, stack_size);            // other data can be shown too, it just doesn't share pages with the others
+//
+// Usage:
+//   // Draw each hex byte as a single glyph (after adding fonts, before the renderer uploads the font texture):
+//   static MemoryEditorHexGlyphs hex_glyphs;
+//   if (hex_glyphs.Build(io.Fonts, io.Fonts->Fonts[0]))
+//       mem_edit.HexGlyphs = &hex_glyphs;
+//
+// Usage:
+//   // Check that a scenario doesn't allocate once warmed up (e.g. in a benchmark or test). Counters are in mem_edit.AllocStats.
+//   MemoryEditorAllocStats::InstallImGuiHooks();       // once at startup: also count ImGui::MemAlloc() calls (ImVector growth, ImGui internals)
+//   mem_edit.AllocCheckWarmupFrames = 10;              // asserts and sets AllocStats.CheckFailed on any allocation after 10 frames
+//   // imgui_memory_editor_benchmark.cpp runs the usual scenarios (scrolling, editing, highlighting...) this way with a headless context.
+//
+// Usage:
+//   // Cap memory used by all editors: recomputable buffers are released first, then cache pages not accessed recently.
+//   static MemoryEditorMemoryBudget memory_budget;
+//   memory_budget.Budget = 512 * 1024 * 1024;
+//   mem_edit_1.MemoryBudget = mem_edit_2.MemoryBudget = &memory_budget;
+//
+// Usage:
+//   // Transform a range programmatically, e.g. to deobfuscate firmware with a 4 bytes xor key:
+//   MemoryEditor::Transform t;
+//   t.Op = MemoryEditor::TransformOp_Xor;
+//   t.KeySize = 4; memcpy(t.Key, "\x5A\xA5\x13\x37", 4);
+//   mem_edit.ApplyTransform(data, 0x1000, 0x80000, t);
+//
+// Usage:
+//   // Writes are recorded for undo/redo (Ctrl+Z, Ctrl+Y). Group your own writes into one undoable step, and cap history:
+//   mem_edit.BeginTransaction();
+//   mem_edit.WriteRange(data, 0x100, patch_1, sizeof(patch_1));
+//   mem_edit.WriteRange(data, 0x800, patch_2, sizeof(patch_2));
+//   mem_edit.EndTransaction();
+//   mem_edit.GetShared().Journal.MemoryCap = 16 * 1024 * 1024;    // transactions above SpillThreshold go to a temporary file
+//
+// Usage:
+//   // Edit a file with insertion (Ctrl+Shift+V) and deletion (Delete) of bytes (Linux, with IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES). Edits are kept in memory until saved.
+//   static MemoryEditorFileSource file_source;
+//   file_source.Open("firmware.bin", true);
+//   mem_edit.DrawWindow("firmware.bin", &file_source);
+//   if (ctrl_s_pressed && file_source.IsModified())
+//       file_source.Save();                                         // in place (dirty pages only) when only overwrites were made, else through a temporary file
+//   file_source.SyncMode = MemoryEditorFileSource::SyncMode_None;   // skip fdatasync() when durability doesn't matter
+//   file_source.SaveAs("firmware_patched.bin");                     // unchanged extents are copied by the kernel (copy_file_range/reflink)
+//
+// Usage:
+//   // Export a range to a file (xxd, C/Rust array, Intel HEX, S-record, raw binary...), written 1 MB at a time by a background job.
+//   // Also available from the options menu. Progress is in mem_edit.Export.Job. Bytes go to a temporary file next to the destination, which only replaces it once complete.
+//   mem_edit.StartExport(data, 0, data_size, MemoryEditor::TextFormat_IntelHex, "firmware.hex", 16, 8, 0x08000000, 0);
+//
+// Usage:
+//   // View a firmware image from an Intel HEX, S-record or xxd file. Only decoded bytes are kept, gaps between regions are collapsed
+//   // and rows display the real addresses (also used by the address input).
+//   static MemoryEditorSparseSource sparse_source;
+//   if (!sparse_source.Load("firmware.hex"))
+//       printf("line %d: %s\n", (int)sparse_source.ErrorLine, sparse_source.Error);
+//   mem_edit.DrawWindow("Firmware", &sparse_source);
+//
 // Changelog:
 // - v0.10: initial version
 // - v0.23 (2017/08/17): added to github. fixed right-arrow triggering a byte write.
@@ -42,6 +153,21 @@
 // - v0.51 (2024/02/22): fix for layout change in 1.89 when using IMGUI_DISABLE_OBSOLETE_FUNCTIONS. (#34)
 // - v0.52 (2024/03/08): removed unnecessary GetKeyIndex() calls, they are a no-op since 1.87.
 // - v0.53 (2024/05/27): fixed right-click popup from not appearing when using DrawContents(). warning fixes. (#35)
+// - v0.60 (2026/10/18): large update for big, live or remote data:
+//   - data access: region access policies (AddRegion(), Refresh()) and RefreshRate, served from a page cache. MemoryEditorDataSource interface (Source setting,
+//     DrawWindow()/DrawContents() overloads) with change tracking and unreadable ranges. SnapshotVersionFn for coherent frames of data written by another thread.
+//   - data sources: MemoryEditorProcessSource, MemoryEditorSharedMemorySource, MemoryEditorFileSource (insertion/deletion through a piece table, Save()/SaveAs()),
+//     MemoryEditorSparseSource (Intel HEX, S-record and xxd files). WriteWatch and OptSafeReads for memory of this process.
+//     Linux sources and settings require #define IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES: POSIX/Linux system headers are not included otherwise.
+//   - background work: MemoryEditorJobSystem shared worker pool (JobSystem setting), time-sliced in DrawContents() without threads (JobTimeBudget).
+//     #define IMGUI_MEMORY_EDITOR_NO_THREADS to disable threads. byte pattern search ("Find" field), rows of the next frame formatted ahead.
+//   - MemoryEditor::SharedState (Shared setting): several views share one page cache, regions, highlight layers (AddHighlight()), search match and undo history.
+//   - editing: range selection, copy (Ctrl+C, CopyFormat) and export (StartExport(), ExportFormat) in several text formats, paste of hex (Ctrl+V),
+//     fill/transforms (ApplyTransform()), undo/redo (Ctrl+Z, Ctrl+Y, OptUndo, BeginTransaction()/EndTransaction()).
+//   - performance: MemoryEditorHexGlyphs (one quad per byte, ImGui < 1.92), MemoryEditorAllocator, no allocations in steady state (AllocStats,
+//     AllocCheckWarmupFrames, see imgui_memory_editor_benchmark.cpp), MemoryEditorMemoryBudget.
+//   - MemoryEditorEngine holds data access, caching, search and formatting without needing an ImGui context. MemoryEditor derives from it.
+//   - FormatBinary() writes into a caller buffer, data preview formatting is reentrant.
 //
 // Todo/Bugs:
 // - This is generally old/crappy code, it should work but isn't very good.. to be rewritten some day.
@@ -49,34 +175,4992 @@
 // - Arrows are being sent to the InputText() about to disappear which for LeftArrow makes the text cursor appear at position 1 for one frame.
 // - Using InputText() is awkward and maybe overkill here, consider implementing something custom.
 
-#pragma once
+#pragma once
+
+#include <stdio.h>      // sprintf, scanf
+#include <stdint.h>     // uint8_t, etc.
+#include <stdlib.h>     // qsort
+#include <limits.h>     // INT_MAX
+#include <errno.h>      // errno
+#include <atomic>       // std::atomic, std::atomic_thread_fence
+#include <chrono>       // std::chrono::steady_clock
+#if !defined(IMGUI_MEMORY_EDITOR_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define IMGUI_MEMORY_EDITOR_SSE2
+#include <emmintrin.h>  // _mm_loadu_si128, etc.
+#endif
+#ifndef IMGUI_MEMORY_EDITOR_NO_THREADS
+#include <thread>       // std::thread
+#include <mutex>        // std::mutex, std::recursive_mutex
+#include <condition_variable>
+#endif
+#if defined(IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES) && defined(__linux__)
+#define IMGUI_MEMORY_EDITOR_POSIX
+#include <fcntl.h>      // open
+#include <unistd.h>     // pread, pwrite, close, sysconf
+#include <sys/uio.h>    // process_vm_readv, process_vm_writev
+#include <sys/mman.h>   // mprotect
+#include <signal.h>     // sigaction
+#include <sched.h>      // sched_yield
+#include <sys/syscall.h> // SYS_mprotect
+#include <sys/stat.h>   // fstat
+#include <sys/shm.h>    // shmat, shmctl
+#include <sys/ioctl.h>  // ioctl
+#include <linux/fs.h>   // FICLONE
+#endif
+
+#if defined(_MSC_VER) || defined(_UCRT)
+#define _PRISizeT   "I"
+#define ImSnprintf  _snprintf
+#else
+#define _PRISizeT   "z"
+#define ImSnprintf  snprintf
+#endif
+
+#if defined(_MSC_VER) || defined(_UCRT)
+#pragma warning (push)
+#pragma warning (disable: 4996) // warning C4996: 'sprintf': This function or variable may be unsafe.
+#endif
+
+// Allocation counters of an editor (see MemoryEditor::AllocStats). Allocator counters are also updated by job threads.
+struct MemoryEditorAllocStats
+{
+    std::atomic<int>    AllocCount, FreeCount;  // calls to MemoryEditorAllocator (page cache blocks, frame arena)
+    std::atomic<size_t> AllocBytes, FreeBytes;
+    std::atomic<size_t> HighWaterBytes;         // highest value of AllocBytes - FreeBytes
+    int             FrameAllocCount;            // allocations made by the calling thread during the last DrawContents(), when tracked
+    int             FrameCount;                 // DrawContents() calls while tracked
+    bool            CheckFailed;                // benchmark mode: DrawContents() allocated after the warm-up frames
+
+    MemoryEditorAllocStats() { AllocCount = FreeCount = 0; AllocBytes = FreeBytes = HighWaterBytes = 0; FrameAllocCount = FrameCount = 0; CheckFailed = false; }
+    MemoryEditorAllocStats(const MemoryEditorAllocStats&) : MemoryEditorAllocStats() {}
+    MemoryEditorAllocStats& operator=(const MemoryEditorAllocStats&) { return *this; }     // counters belong to their editor: not copied
+    size_t GetLiveBytes() const { return AllocBytes.load() - FreeBytes.load(); }
+
+    void OnAlloc(size_t size)
+    {
+        AllocCount++;
+        const size_t live = (AllocBytes += size) - FreeBytes.load();
+        size_t high_water = HighWaterBytes.load();
+        while (live > high_water && !HighWaterBytes.compare_exchange_weak(high_water, live)) {}
+    }
+    void OnFree(size_t size)
+    {
+        FreeCount++;
+        FreeBytes += size;
+    }
+
+    // Allocations made by the current thread through a MemoryEditorAllocator, and through ImGui::MemAlloc() once InstallImGuiHooks() was called.
+    static int& GetThreadAllocCount()   { static thread_local int count = 0; return count; }
+    static bool IsImGuiHooked()         { return GetHookedAllocFn() != NULL; }
+
+    // Wrap ImGui allocator functions once for the whole process, so that DrawContents() also counts ImGui::MemAlloc() calls (ImVector growth,
+    // ImGui internals) of its thread. Call at startup, after any ImGui::SetAllocatorFunctions() and before other threads use ImGui.
+    static void InstallImGuiHooks()
+    {
+        if (IsImGuiHooked())
+            return;
+        void* user_data = NULL;
+        ImGui::GetAllocatorFunctions(&GetHookedAllocFn(), &GetHookedFreeFn(), &user_data);
+        GetHookedUserData() = user_data;
+        ImGui::SetAllocatorFunctions(HookAllocFn, HookFreeFn, NULL);
+    }
+
+    // [Internal]
+    static ImGuiMemAllocFunc&   GetHookedAllocFn()  { static ImGuiMemAllocFunc fn = NULL; return fn; }
+    static ImGuiMemFreeFunc&    GetHookedFreeFn()   { static ImGuiMemFreeFunc fn = NULL; return fn; }
+    static void*&               GetHookedUserData() { static void* user_data = NULL; return user_data; }
+    static void* HookAllocFn(size_t size, void*)    { GetThreadAllocCount()++; return GetHookedAllocFn()(size, GetHookedUserData()); }
+    static void  HookFreeFn(void* ptr, void*)       { GetHookedFreeFn()(ptr, GetHookedUserData()); }
+};
+
+// Allocator for internal buffers (page cache blocks, frame arena). Defaults to ImGui::MemAlloc()/MemFree().
+// ImVector<> members always use ImGui::MemAlloc(): use ImGui::SetAllocatorFunctions() to redirect them too.
+struct MemoryEditorAllocator
+{
+    void*           (*AllocFn)(size_t size, void* user_data);   // = NULL
+    void            (*FreeFn)(void* ptr, void* user_data);      // = NULL
+    void*           UserData;                                   // = NULL
+    MemoryEditorAllocStats* Stats;                              // = NULL   // optional counters
+
+    MemoryEditorAllocator() { AllocFn = NULL; FreeFn = NULL; UserData = NULL; Stats = NULL; }
+    void* Alloc(size_t size) const
+    {
+        if (Stats)
+            Stats->OnAlloc(size);
+        if (AllocFn || !MemoryEditorAllocStats::IsImGuiHooked())
+            MemoryEditorAllocStats::GetThreadAllocCount()++;        // else counted by the ImGui hook
+        return AllocFn ? AllocFn(size, UserData) : IM_ALLOC(size);
+    }
+    void Free(void* ptr, size_t size) const
+    {
+        if (Stats)
+            Stats->OnFree(size);
+        if (FreeFn)
+            FreeFn(ptr, UserData);
+        else
+            IM_FREE(ptr);
+    }
+    bool IsSameHeap(const MemoryEditorAllocator& rhs) const { return AllocFn == rhs.AllocFn && FreeFn == rhs.FreeFn && UserData == rhs.UserData; }
+};
+
+// Bump allocator for buffers only needed during a frame (e.g. visible rows). Reset() releases everything at once.
+// Allocations which don't fit are served by the allocator and the capacity grows on next Reset(), so steady state has no heap traffic.
+struct MemoryEditorFrameArena
+{
+    MemoryEditorAllocator Allocator;
+    char*           Data;
+    size_t          Capacity;
+    size_t          Used;
+    size_t          Requested;                  // bytes requested since last Reset(), including overflow
+    ImVector<void*> Overflow;
+    ImVector<size_t> OverflowSizes;
+
+    MemoryEditorFrameArena() { Data = NULL; Capacity = Used = Requested = 0; }
+    MemoryEditorFrameArena(const MemoryEditorFrameArena& src) { Data = NULL; Capacity = Used = Requested = 0; Allocator = src.Allocator; }
+    MemoryEditorFrameArena& operator=(const MemoryEditorFrameArena& src) { if (this != &src) { ReleaseMemory(); Allocator = src.Allocator; } return *this; }
+    ~MemoryEditorFrameArena() { ReleaseMemory(); }
+
+    void* Alloc(size_t size)
+    {
+        size = (size + 15) & ~(size_t)15;
+        Requested += size;
+        if (Used + size <= Capacity)
+        {
+            void* ptr = Data + Used;
+            Used += size;
+            return ptr;
+        }
+        void* ptr = Allocator.Alloc(size);
+        Overflow.push_back(ptr);
+        OverflowSizes.push_back(size);
+        return ptr;
+    }
+
+    void Reset()
+    {
+        for (int n = 0; n < Overflow.Size; n++)
+            Allocator.Free(Overflow[n], OverflowSizes[n]);
+        Overflow.resize(0);
+        OverflowSizes.resize(0);
+        if (Requested > Capacity)
+        {
+            if (Data)
+                Allocator.Free(Data, Capacity);
+            Capacity = Requested + Requested / 2;
+            Data = (char*)Allocator.Alloc(Capacity);
+        }
+        Used = Requested = 0;
+    }
+
+    void SetAllocator(const MemoryEditorAllocator& allocator)
+    {
+        if (!Allocator.IsSameHeap(allocator))
+            ReleaseMemory();
+        Allocator = allocator;
+    }
+
+    void ReleaseMemory()
+    {
+        Reset();
+        if (Data)
+            Allocator.Free(Data, Capacity);
+        Data = NULL;
+        Capacity = 0;
+        Overflow.clear();
+        OverflowSizes.clear();
+    }
+};
+
+// Cache of bytes read from the target memory, stored in fixed-size pages sorted by index.
+// Each byte has a valid bit, so a page may be partially filled (e.g. only the bytes of a cacheable region).
+// Pages are allocated in blocks of PagesPerBlock and recycled through a free list: blocks are only released by ReleaseMemory().
+struct MemoryEditorPageCache
+{
+    enum { PageSizeShift = 12, PageSize = 1 << PageSizeShift, PagesPerBlock = 16 };
+
+    struct Page
+    {
+        size_t  Index;                          // Offset >> PageSizeShift
+        ImU32   LastUse;                        // UseClock when last accessed
+        ImU32   ValidMask[PageSize / 32];       // 1 bit per byte, set when Data[] holds a value read from the target
+        ImU8    Data[PageSize];
+    };
+
+    ImVector<Page*> Pages;                      // Sorted by Index
+    ImVector<Page*> FreePages;
+    ImVector<Page*> Blocks;                     // Each block is an array of PagesPerBlock pages
+    MemoryEditorAllocator Allocator;
+    ImU32           UseClock;                   // incremented once per frame by the editor: pages not accessed since are cold
+
+    MemoryEditorPageCache() { UseClock = 0; }
+    MemoryEditorPageCache(const MemoryEditorPageCache& src) : MemoryEditorPageCache() { *this = src; }
+    MemoryEditorPageCache& operator=(const MemoryEditorPageCache& src)
+    {
+        if (this == &src)
+            return *this;
+        SetAllocator(src.Allocator);
+        Clear();
+        for (int n = 0; n < src.Pages.Size; n++)
+            memcpy(GetPage(src.Pages[n]->Index, true), src.Pages[n], sizeof(Page));
+        return *this;
+    }
+    ~MemoryEditorPageCache() { ReleaseMemory(); }
+
+    void Clear()
+    {
+        for (int n = 0; n < Pages.Size; n++)
+            FreePages.push_back(Pages[n]);
+        Pages.resize(0);
+    }
+
+    void ReleaseMemory()
+    {
+        for (int n = 0; n < Blocks.Size; n++)
+            Allocator.Free(Blocks[n], sizeof(Page) * PagesPerBlock);
+        Pages.clear();
+        FreePages.clear();
+        Blocks.clear();
+    }
+
+    void SetAllocator(const MemoryEditorAllocator& allocator)
+    {
+        if (!Allocator.IsSameHeap(allocator))
+            ReleaseMemory();
+        Allocator = allocator;
+    }
+
+    // Return index of first page with Index >= page_index
+    int FindPageLowerBound(size_t page_index) const
+    {
+        int lo = 0, hi = Pages.Size;
+        while (lo < hi)
+        {
+            int mid = (lo + hi) >> 1;
+            if (Pages.Data[mid]->Index < page_index)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    Page* GetPage(size_t page_index, bool create)
+    {
+        int n = FindPageLowerBound(page_index);
+        if (n < Pages.Size && Pages.Data[n]->Index == page_index)
+        {
+            Pages.Data[n]->LastUse = UseClock;
+            return Pages.Data[n];
+        }
+        if (!create)
+            return NULL;
+        if (FreePages.Size == 0)
+        {
+            Page* block = (Page*)Allocator.Alloc(sizeof(Page) * PagesPerBlock);
+            Blocks.push_back(block);
+            for (int i = PagesPerBlock - 1; i >= 0; i--)
+                FreePages.push_back(block + i);
+        }
+        Page* page = FreePages.back();
+        FreePages.pop_back();
+        Pages.insert(Pages.Data + n, page);
+        page->Index = page_index;
+        page->LastUse = UseClock;
+        memset(page->ValidMask, 0, sizeof(page->ValidMask));
+        return page;
+    }
+
+    size_t GetMemoryUsage() const { return (size_t)Blocks.Size * sizeof(Page) * PagesPerBlock; }
+
+    static int CompareU64(const void* lhs, const void* rhs)
+    {
+        const ImU64 a = *(const ImU64*)lhs, b = *(const ImU64*)rhs;
+        return (a < b) ? -1 : (a > b) ? 1 : 0;
+    }
+
+    static int ComparePointers(const void* lhs, const void* rhs)
+    {
+        const uintptr_t a = (uintptr_t)*(void* const*)lhs, b = (uintptr_t)*(void* const*)rhs;
+        return (a < b) ? -1 : (a > b) ? 1 : 0;
+    }
+
+    // Release pages not accessed since UseClock was last incremented, least recently used first, until 'bytes' can be freed.
+    // Return number of bytes freed.
+    size_t EvictColdPages(size_t bytes)
+    {
+        const size_t block_bytes = sizeof(Page) * PagesPerBlock;
+        const int free_block_count = (int)((bytes + block_bytes - 1) / block_bytes);
+        const int keep_page_count = (Blocks.Size > free_block_count) ? (Blocks.Size - free_block_count) * PagesPerBlock : 0;
+        int evict_count = Pages.Size - keep_page_count;
+        if (evict_count > 0)
+        {
+            // Sort cold pages by age, oldest first
+            ImVector<ImU64> cold_pages;
+            for (int n = 0; n < Pages.Size; n++)
+                if (Pages.Data[n]->LastUse != UseClock)
+                    cold_pages.push_back(((ImU64)(0xFFFFFFFF - (UseClock - Pages.Data[n]->LastUse)) << 32) | (ImU32)n);
+            if (cold_pages.Size > 1)
+                qsort(cold_pages.Data, (size_t)cold_pages.Size, sizeof(ImU64), CompareU64);
+            if (evict_count > cold_pages.Size)
+                evict_count = cold_pages.Size;
+            for (int i = 0; i < evict_count; i++)
+            {
+                const int n = (int)(cold_pages[i] & 0xFFFFFFFF);
+                FreePages.push_back(Pages.Data[n]);
+                Pages.Data[n] = NULL;
+            }
+            int dst = 0;
+            for (int n = 0; n < Pages.Size; n++)
+                if (Pages.Data[n] != NULL)
+                    Pages.Data[dst++] = Pages.Data[n];
+            Pages.resize(dst);
+        }
+        return Trim();
+    }
+
+    // Free blocks which hold no page. Pages of the least used blocks are first moved into free slots of the others.
+    // Return number of bytes freed.
+    size_t Trim()
+    {
+        const int keep_count = (Pages.Size + PagesPerBlock - 1) / PagesPerBlock;
+        if (Blocks.Size <= keep_count)
+            return 0;
+
+        // Count pages in each block, keep the fullest ones
+        struct BlockInfo { ImU32 UsedMask; int PageCount; bool Keep; };
+        qsort(Blocks.Data, (size_t)Blocks.Size, sizeof(Page*), ComparePointers);
+        ImVector<BlockInfo> infos;
+        infos.resize(Blocks.Size);
+        memset(infos.Data, 0, (size_t)infos.Size * sizeof(BlockInfo));
+        ImVector<int> page_blocks;
+        page_blocks.resize(Pages.Size);
+        for (int n = 0; n < Pages.Size; n++)
+        {
+            int lo = 0, hi = Blocks.Size - 1;
+            while (lo < hi)
+            {
+                const int mid = (lo + hi + 1) >> 1;
+                if ((uintptr_t)Blocks.Data[mid] <= (uintptr_t)Pages.Data[n])
+                    lo = mid;
+                else
+                    hi = mid - 1;
+            }
+            page_blocks[n] = lo;
+            infos[lo].UsedMask |= (ImU32)1 << (Pages.Data[n] - Blocks.Data[lo]);
+            infos[lo].PageCount++;
+        }
+        ImVector<ImU64> order;
+        for (int i = 0; i < Blocks.Size; i++)
+            order.push_back(((ImU64)(PagesPerBlock - infos[i].PageCount) << 32) | (ImU32)i);
+        qsort(order.Data, (size_t)order.Size, sizeof(ImU64), CompareU64);
+        for (int i = 0; i < keep_count; i++)
+            infos[(int)(order[i] & 0xFFFFFFFF)].Keep = true;
+
+        // Move pages out of released blocks
+        FreePages.resize(0);
+        for (int i = 0; i < Blocks.Size; i++)
+            if (infos[i].Keep)
+                for (int slot = PagesPerBlock - 1; slot >= 0; slot--)
+                    if ((infos[i].UsedMask & ((ImU32)1 << slot)) == 0)
+                        FreePages.push_back(Blocks[i] + slot);
+        for (int n = 0; n < Pages.Size; n++)
+        {
+            if (infos[page_blocks[n]].Keep)
+                continue;
+            Page* page = FreePages.back();
+            FreePages.pop_back();
+            memcpy(page, Pages.Data[n], sizeof(Page));
+            Pages.Data[n] = page;
+        }
+        int dst = 0;
+        for (int i = 0; i < Blocks.Size; i++)
+        {
+            if (infos[i].Keep)
+                Blocks[dst++] = Blocks[i];
+            else
+                Allocator.Free(Blocks[i], sizeof(Page) * PagesPerBlock);
+        }
+        const size_t freed = (size_t)(Blocks.Size - dst) * sizeof(Page) * PagesPerBlock;
+        Blocks.resize(dst);
+        return freed;
+    }
+
+    // Clear valid bits of [off, off+size). Only touches pages which already exist.
+    void Invalidate(size_t off, size_t size)
+    {
+        if (size == 0)
+            return;
+        const size_t end = off + size;
+        for (int n = FindPageLowerBound(off >> PageSizeShift); n < Pages.Size; n++)
+        {
+            Page& page = *Pages.Data[n];
+            const size_t page_off = page.Index << PageSizeShift;
+            if (page_off >= end)
+                break;
+            const size_t i_min = (off > page_off) ? off - page_off : 0;
+            const size_t i_max = (end - page_off < (size_t)PageSize) ? end - page_off : (size_t)PageSize;
+            for (size_t i = i_min; i < i_max; i++)
+                page.ValidMask[i >> 5] &= ~((ImU32)1 << (i & 31));
+        }
+    }
+
+    // Store [off, off+size) into pages, creating them if needed.
+    void Store(size_t off, const ImU8* src, size_t size)
+    {
+        while (size > 0)
+        {
+            Page* page = GetPage(off >> PageSizeShift, true);
+            const size_t i_min = off & (PageSize - 1);
+            const size_t count = ((size_t)PageSize - i_min < size) ? (size_t)PageSize - i_min : size;
+            memcpy(page->Data + i_min, src, count);
+            for (size_t i = i_min; i < i_min + count; i++)
+                page->ValidMask[i >> 5] |= ((ImU32)1 << (i & 31));
+            off += count;
+            src += count;
+            size -= count;
+        }
+    }
+
+    void RemoveEmptyPages()
+    {
+        int dst = 0;
+        for (int n = 0; n < Pages.Size; n++)
+        {
+            bool empty = true;
+            for (int i = 0; i < PageSize / 32 && empty; i++)
+                empty = (Pages.Data[n]->ValidMask[i] == 0);
+            if (empty)
+                FreePages.push_back(Pages.Data[n]);
+            else
+                Pages.Data[dst++] = Pages.Data[n];
+        }
+        Pages.resize(dst);
+    }
+
+    // Update bytes already present in the cache (write-through), leave other bytes untouched.
+    // Update bytes of [off, off+size) which are in existing pages.
+    void Update(size_t off, const ImU8* src, size_t size)
+    {
+        while (size > 0)
+        {
+            const size_t i_min = off & (PageSize - 1);
+            const size_t count = ((size_t)PageSize - i_min < size) ? (size_t)PageSize - i_min : size;
+            if (Page* page = GetPage(off >> PageSizeShift, false))
+                memcpy(page->Data + i_min, src, count);
+            off += count;
+            src += count;
+            size -= count;
+        }
+    }
+};
+
+// Memory budget shared by any number of editors (set MemoryEditor::MemoryBudget). Subsystems holding memory (page caches, prepared rows,
+// search buffers...) register a Consumer which reports its usage. When the total exceeds Budget, Update() asks consumers to release memory
+// in priority order: recomputable data first, then cold cache pages, then snapshots and history. Not thread-safe: use from the UI thread.
+struct MemoryEditorMemoryBudget
+{
+    enum EvictPriority_
+    {
+        EvictPriority_Recomputable = 0,     // e.g. prepared rows, analysis results: recomputed when needed
+        EvictPriority_ColdPages,            // cached pages not accessed recently: read again from the target when needed
+        EvictPriority_Snapshots,            // e.g. snapshots, undo history: lost when evicted, oldest first
+        EvictPriority_Never,                // only reported, e.g. buffers of the current frame
+        EvictPriority_COUNT
+    };
+
+    struct Consumer
+    {
+        const char*     Name;
+        int             Priority;                               // EvictPriority_
+        size_t          Usage;                                  // bytes held, kept up to date by the owner
+        size_t          EvictedBytes;                           // bytes released on request of the budget
+        size_t          (*EvictFn)(Consumer* consumer, size_t bytes);   // release 'bytes' or as much as possible, update Usage and return number of bytes released
+        void*           UserData;
+        MemoryEditorMemoryBudget* Budget;                       // set by Register()
+
+        Consumer(const char* name = NULL, int priority = EvictPriority_Never, size_t (*evict_fn)(Consumer*, size_t) = NULL) { Name = name; Priority = priority; Usage = EvictedBytes = 0; EvictFn = evict_fn; UserData = NULL; Budget = NULL; }
+        Consumer(const Consumer& src) : Consumer(src.Name, src.Priority, src.EvictFn) {}   // copies are not registered
+        Consumer& operator=(const Consumer& src) { Name = src.Name; Priority = src.Priority; EvictFn = src.EvictFn; return *this; }
+        ~Consumer() { if (Budget) Budget->Unregister(this); }
+    };
+
+    size_t          Budget;                                     // = 0      // bytes, 0: unlimited
+    ImVector<Consumer*> Consumers;
+    size_t          PeakUsage;
+    size_t          EvictedBytes;
+    int             EvictCount;                                 // number of EvictFn calls
+    bool            OverBudget;                                 // last Update() couldn't release enough memory
+
+    MemoryEditorMemoryBudget() { Budget = 0; PeakUsage = EvictedBytes = 0; EvictCount = 0; OverBudget = false; }
+    MemoryEditorMemoryBudget(const MemoryEditorMemoryBudget&) = delete;
+    MemoryEditorMemoryBudget& operator=(const MemoryEditorMemoryBudget&) = delete;
+    ~MemoryEditorMemoryBudget() { for (Consumer* consumer : Consumers) consumer->Budget = NULL; }
+
+    void Register(Consumer* consumer)
+    {
+        IM_ASSERT(consumer->Budget == NULL);
+        Consumers.push_back(consumer);
+        consumer->Budget = this;
+    }
+
+    void Unregister(Consumer* consumer)
+    {
+        for (int n = 0; n < Consumers.Size; n++)
+            if (Consumers[n] == consumer)
+            {
+                Consumers.erase(Consumers.Data + n);
+                break;
+            }
+        consumer->Budget = NULL;
+    }
+
+    // Register 'consumer' with 'budget', moving it from its previous budget if needed. A NULL budget unregisters it.
+    static void Attach(Consumer* consumer, MemoryEditorMemoryBudget* budget, void* user_data)
+    {
+        consumer->UserData = user_data;
+        if (consumer->Budget == budget)
+            return;
+        if (consumer->Budget)
+            consumer->Budget->Unregister(consumer);
+        if (budget)
+            budget->Register(consumer);
+    }
+
+    // Total usage, or usage of consumers of a given priority
+    size_t GetUsage(int priority = -1) const
+    {
+        size_t usage = 0;
+        for (const Consumer* consumer : Consumers)
+            if (priority < 0 || consumer->Priority == priority)
+                usage += consumer->Usage;
+        return usage;
+    }
+
+    // Release memory when over budget. Called by editors once per frame, after updating usage of their consumers.
+    void Update()
+    {
+        size_t usage = GetUsage();
+        if (usage > PeakUsage)
+            PeakUsage = usage;
+        OverBudget = false;
+        if (Budget == 0 || usage <= Budget)
+            return;
+        for (int priority = 0; priority < EvictPriority_Never && usage > Budget; priority++)
+            for (int n = 0; n < Consumers.Size && usage > Budget; n++)
+            {
+                Consumer* consumer = Consumers[n];
+                if (consumer->Priority != priority || consumer->EvictFn == NULL || consumer->Usage == 0)
+                    continue;
+                const size_t released = consumer->EvictFn(consumer, usage - Budget);
+                consumer->EvictedBytes += released;
+                EvictedBytes += released;
+                EvictCount++;
+                usage = GetUsage();
+            }
+        OverBudget = (usage > Budget);
+    }
+};
+
+// Undo/redo history of writes. Each transaction is a list of deltas (addr, old bytes, new bytes, ByteState of old bytes), all run-length encoded so fills
+// cost a few bytes. Old bytes which weren't valid (unreadable or never read) are not written back by undo.
+// Encoded bytes of transactions larger than SpillThreshold are moved to a temporary file. Oldest transactions are dropped above MemoryCap/SpillCap.
+// The journal only stores data: MemoryEditorEngine records its writes in it and replays them (see MemoryEditorEngine::Undo()).
+struct MemoryEditorUndoJournal
+{
+    enum { ChunkSize = 256 * 1024 };            // max bytes per delta: larger writes are recorded as several deltas
+
+    struct Delta
+    {
+        size_t  Addr;
+        size_t  Size;
+        size_t  OldEncodedSize;                 // old bytes are stored at Offset, new bytes at Offset + OldEncodedSize, old states after new bytes
+        size_t  NewEncodedSize;
+        size_t  StateEncodedSize;
+        ImU64   Offset;                         // position in the Data stream, or in SpillFile when the transaction is spilled
+    };
+
+    struct Transaction
+    {
+        ImU64   DeltaBegin, DeltaEnd;           // deltas, as positions in the Deltas stream
+        ImU64   DataBegin, DataEnd;             // encoded bytes, as positions in the Data stream or in SpillFile
+        size_t  Size;                           // bytes written
+        bool    Spilled;
+    };
+
+    // Settings
+    size_t          MemoryCap;                  // = 64 MB  // memory used by history (encoded bytes and deltas). oldest transactions are dropped above it.
+    size_t          SpillThreshold;             // = 8 MB   // transactions with more encoded bytes are moved to a temporary file. 0: never spill.
+    ImU64           SpillCap;                   // = 4 GB   // encoded bytes kept in the temporary file. oldest transactions are dropped above it.
+
+    // [Internal State]
+    ImVector<Transaction> Transactions;         // [0, UndoCount) can be undone, [UndoCount, Size) can be redone
+    int             UndoCount;
+    ImVector<Delta> Deltas;                     // deltas of all transactions, Deltas[0] is at position DeltasBase of the stream
+    ImU64           DeltasBase;
+    ImVector<ImU8>  Data;                       // encoded bytes of transactions in memory, Data[0] is at position DataBase of the stream
+    ImU64           DataBase;
+    FILE*           SpillFile;                  // tmpfile(), opened on first spill
+    ImU64           SpillSize;                  // end of spilled data
+    int             Depth;                      // BeginTransaction() nesting
+    bool            Overflow;                   // current transaction couldn't be recorded: history is cleared when it ends
+    bool            Replaying;                  // writes are not recorded while undoing/redoing
+    ImVector<ImU8>  Scratch;                    // encoding/decoding buffer
+    ImVector<ImU8>  ReadBuf;                    // old bytes and their states read by the editor before a write
+    size_t          DroppedCount;               // transactions dropped because of caps or a memory budget
+
+    MemoryEditorUndoJournal() { MemoryCap = 64 * 1024 * 1024; SpillThreshold = 8 * 1024 * 1024; SpillCap = (ImU64)4 << 30; UndoCount = 0; DeltasBase = DataBase = SpillSize = 0; SpillFile = NULL; Depth = 0; Overflow = Replaying = false; DroppedCount = 0; }
+    MemoryEditorUndoJournal(const MemoryEditorUndoJournal& src) : MemoryEditorUndoJournal() { *this = src; }
+    MemoryEditorUndoJournal& operator=(const MemoryEditorUndoJournal& src) { MemoryCap = src.MemoryCap; SpillThreshold = src.SpillThreshold; SpillCap = src.SpillCap; return *this; } // copies settings only
+    ~MemoryEditorUndoJournal() { if (SpillFile) fclose(SpillFile); }
+
+    bool    CanUndo() const                         { return Depth == 0 && UndoCount > 0; }
+    bool    CanRedo() const                         { return Depth == 0 && UndoCount < Transactions.Size; }
+    bool    IsTransactionInRange(const Transaction& tx, size_t addr, size_t size) const { for (ImU64 n = tx.DeltaBegin; n < tx.DeltaEnd; n++) if (GetDelta(n).Addr - addr > size || GetDelta(n).Size > size - (GetDelta(n).Addr - addr)) return false; return true; }
+    void    Rebase(size_t shift)                    { for (Delta& delta : Deltas) delta.Addr += shift; } // addresses are offsets: keep them on the same bytes when the origin moves
+    Delta&  GetDelta(ImU64 pos)                     { return Deltas.Data[pos - DeltasBase]; }
+    const Delta& GetDelta(ImU64 pos) const          { return Deltas.Data[pos - DeltasBase]; }
+    size_t  GetMemoryUsage() const                  { return (size_t)(Data.Capacity + Deltas.Capacity * sizeof(Delta) + Transactions.Capacity * sizeof(Transaction) + Scratch.Capacity + ReadBuf.Capacity); }
+
+    // Clear history. When called during a transaction which already recorded writes, writes are not recorded until it ends.
+    void Clear()
+    {
+        const bool keep_transaction = (Depth > 0 && !Overflow && Transactions.back().DeltaBegin == Transactions.back().DeltaEnd);
+        ClearStreams();
+        Overflow = (Depth > 0 && !keep_transaction);
+        if (keep_transaction)
+        {
+            Transaction tx;
+            tx.DeltaBegin = tx.DeltaEnd = DeltasBase;
+            tx.DataBegin = tx.DataEnd = DataBase;
+            tx.Size = 0;
+            tx.Spilled = false;
+            Transactions.push_back(tx);
+            UndoCount = Transactions.Size;
+        }
+    }
+
+    // Group writes into one transaction. Transactions may nest: only the outermost one is recorded.
+    void BeginTransaction()
+    {
+        if (Depth++ > 0)
+            return;
+        // A new transaction discards transactions which could be redone
+        while (UndoCount < Transactions.Size)
+            DropTransaction(Transactions.Size - 1);
+        Transaction tx;
+        tx.DeltaBegin = tx.DeltaEnd = DeltasBase + Deltas.Size;
+        tx.DataBegin = tx.DataEnd = DataBase + Data.Size;
+        tx.Size = 0;
+        tx.Spilled = false;
+        Transactions.push_back(tx);
+        UndoCount = Transactions.Size;
+        Overflow = false;
+    }
+
+    void EndTransaction()
+    {
+        IM_ASSERT(Depth > 0);
+        if (--Depth > 0)
+            return;
+        if (Overflow)
+        {
+            // Earlier transactions can't be undone consistently without this one
+            Clear();
+            Overflow = false;
+            return;
+        }
+        if (Transactions.back().DeltaBegin == Transactions.back().DeltaEnd)
+            DropTransaction(Transactions.Size - 1);
+        while (Transactions.Size > 0 && (GetLiveMemory() > MemoryCap || GetLiveSpill() > SpillCap))
+            DropOldest();
+    }
+
+    // Record a write of 'size' bytes at 'addr' in the current transaction. 'old_state' holds a MemoryEditorEngine::ByteState for each old byte.
+    void Record(size_t addr, const ImU8* old_data, const ImU8* old_state, const ImU8* new_data, size_t size)
+    {
+        IM_ASSERT(Depth > 0 && !Replaying);
+        if (Overflow)
+            return;
+        Transaction& tx = Transactions.back();
+        tx.Size += size;
+        for (size_t off = 0; off < size; off += ChunkSize)
+        {
+            const size_t chunk_size = (size - off < (size_t)ChunkSize) ? size - off : (size_t)ChunkSize;
+            const size_t bound = GetEncodeBound(chunk_size) * 3;
+            Delta delta;
+            delta.Addr = addr + off;
+            delta.Size = chunk_size;
+
+            // Check caps before appending each chunk: Data can't grow past INT_MAX bytes
+            if (!tx.Spilled && SpillThreshold > 0 && tx.DataEnd - tx.DataBegin > (ImU64)SpillThreshold)
+                Spill(tx);
+            if (!tx.Spilled && (tx.DataEnd - tx.DataBegin + bound > (ImU64)MemoryCap || (ImU64)Data.Size + bound > (ImU64)INT_MAX))
+            {
+                Overflow = true;
+                return;
+            }
+            if (!tx.Spilled)
+            {
+                const ImU64 grow_size = (ImU64)Data.Size + bound + Data.Size / 2;
+                Data.reserve(Data.Size + (int)bound > Data.Capacity ? (int)(grow_size < (ImU64)INT_MAX ? grow_size : (ImU64)INT_MAX) : Data.Capacity);
+                ImU8* out = Data.Data + Data.Size;
+                delta.OldEncodedSize = EncodeRLE(old_data + off, chunk_size, out);
+                delta.NewEncodedSize = EncodeRLE(new_data + off, chunk_size, out + delta.OldEncodedSize);
+                delta.StateEncodedSize = EncodeRLE(old_state + off, chunk_size, out + delta.OldEncodedSize + delta.NewEncodedSize);
+                delta.Offset = DataBase + Data.Size;
+                Data.resize(Data.Size + (int)(delta.OldEncodedSize + delta.NewEncodedSize + delta.StateEncodedSize));
+                tx.DataEnd = DataBase + Data.Size;
+            }
+            else
+            {
+                Scratch.resize((int)bound);
+                delta.OldEncodedSize = EncodeRLE(old_data + off, chunk_size, Scratch.Data);
+                delta.NewEncodedSize = EncodeRLE(new_data + off, chunk_size, Scratch.Data + delta.OldEncodedSize);
+                delta.StateEncodedSize = EncodeRLE(old_state + off, chunk_size, Scratch.Data + delta.OldEncodedSize + delta.NewEncodedSize);
+                delta.Offset = SpillSize;
+                if (!WriteSpill(Scratch.Data, delta.OldEncodedSize + delta.NewEncodedSize + delta.StateEncodedSize))
+                {
+                    Overflow = true;
+                    return;
+                }
+                tx.DataEnd = SpillSize;
+            }
+            Deltas.push_back(delta);
+            tx.DeltaEnd = DeltasBase + Deltas.Size;
+        }
+        if (!tx.Spilled && tx.DataEnd - tx.DataBegin > (ImU64)SpillThreshold && SpillThreshold > 0)
+            Spill(tx);
+    }
+
+    // Decode old (or new) bytes of a delta into 'out', and their states into 'out_state' (delta.Size bytes each). New bytes are all valid.
+    bool LoadDelta(const Transaction& tx, const Delta& delta, bool old_bytes, ImU8* out, ImU8* out_state)
+    {
+        if (!old_bytes)
+            memset(out_state, 0, delta.Size);
+        const size_t encoded_size = old_bytes ? delta.OldEncodedSize : delta.NewEncodedSize;
+        const size_t state_encoded_size = old_bytes ? delta.StateEncodedSize : 0;
+        const ImU64 offset = old_bytes ? delta.Offset : delta.Offset + delta.OldEncodedSize;
+        const ImU64 state_offset = delta.Offset + delta.OldEncodedSize + delta.NewEncodedSize;
+        if (!tx.Spilled)
+            return DecodeRLE(Data.Data + (size_t)(offset - DataBase), encoded_size, out, delta.Size) &&
+                (!old_bytes || DecodeRLE(Data.Data + (size_t)(state_offset - DataBase), state_encoded_size, out_state, delta.Size));
+        Scratch.resize((int)(encoded_size + state_encoded_size));
+        if (!SeekSpill(offset) || fread(Scratch.Data, 1, encoded_size, SpillFile) != encoded_size || !DecodeRLE(Scratch.Data, encoded_size, out, delta.Size))
+            return false;
+        if (!old_bytes)
+            return true;
+        return SeekSpill(state_offset) && fread(Scratch.Data, 1, state_encoded_size, SpillFile) == state_encoded_size && DecodeRLE(Scratch.Data, state_encoded_size, out_state, delta.Size);
+    }
+
+    // Drop the oldest transaction which can be undone, or the last one which can be redone. Return number of bytes released.
+    size_t DropOldest()
+    {
+        if (Transactions.Size == 0)
+            return 0;
+        const size_t usage = GetMemoryUsage();
+        if (UndoCount > 0)
+            DropTransaction(0);
+        else
+            DropTransaction(Transactions.Size - 1);
+        DroppedCount++;
+        const size_t new_usage = GetMemoryUsage();
+        return (usage > new_usage) ? usage - new_usage : 0;
+    }
+
+    // [Internal]
+    void ClearStreams()
+    {
+        Transactions.resize(0);
+        UndoCount = 0;
+        DeltasBase += Deltas.Size;
+        DataBase += Data.Size;
+        Deltas.resize(0);
+        Data.resize(0);
+        SpillSize = 0;
+    }
+
+    // Bytes used by encoded data in memory, deltas and transactions
+    size_t GetLiveMemory() const
+    {
+        if (Transactions.Size == 0)
+            return 0;
+        size_t size = (size_t)(DeltasBase + Deltas.Size - Transactions[0].DeltaBegin) * sizeof(Delta) + Transactions.Size * sizeof(Transaction);
+        for (const Transaction& tx : Transactions)
+            if (!tx.Spilled)
+                return size + (size_t)(DataBase + Data.Size - tx.DataBegin);
+        return size;
+    }
+
+    ImU64 GetLiveSpill() const
+    {
+        for (const Transaction& tx : Transactions)
+            if (tx.Spilled)
+                return SpillSize - tx.DataBegin;
+        return 0;
+    }
+
+    void DropTransaction(int n)
+    {
+        IM_ASSERT(n == 0 || n == Transactions.Size - 1);
+        const Transaction tx = Transactions[n];
+        Transactions.erase(Transactions.Data + n);
+        if (n < UndoCount)
+            UndoCount--;
+        if (n > 0 || Transactions.Size == 0)
+        {
+            // Last transaction: truncate streams
+            Deltas.resize((int)(tx.DeltaBegin - DeltasBase));
+            if (!tx.Spilled)
+                Data.resize((int)(tx.DataBegin - DataBase));
+            else
+                SpillSize = tx.DataBegin;
+            if (Transactions.Size == 0)
+                ClearStreams();
+            return;
+        }
+
+        // First transaction: compact streams once half of them is unused
+        const ImU64 deltas_front = Transactions[0].DeltaBegin;
+        if ((deltas_front - DeltasBase) * 2 >= (ImU64)Deltas.Size)
+        {
+            const int shift = (int)(deltas_front - DeltasBase);
+            memmove(Deltas.Data, Deltas.Data + shift, (size_t)(Deltas.Size - shift) * sizeof(Delta));
+            Deltas.resize(Deltas.Size - shift);
+            DeltasBase = deltas_front;
+        }
+        ImU64 data_front = DataBase + Data.Size;
+        for (const Transaction& other_tx : Transactions)
+            if (!other_tx.Spilled)
+            {
+                data_front = other_tx.DataBegin;
+                break;
+            }
+        if ((data_front - DataBase) * 2 >= (ImU64)Data.Size)
+        {
+            const int shift = (int)(data_front - DataBase);
+            memmove(Data.Data, Data.Data + shift, (size_t)(Data.Size - shift));
+            Data.resize(Data.Size - shift);
+            DataBase = data_front;
+            if (Data.Capacity > 1024 * 1024 && Data.Size < Data.Capacity / 4)
+            {
+                ImVector<ImU8> data_copy; // release unused capacity
+                if (Data.Size > 0)
+                    data_copy = Data;
+                Data.swap(data_copy);
+            }
+        }
+        if (GetLiveSpill() == 0)
+            SpillSize = 0;
+    }
+
+    // Move encoded bytes of 'tx' to SpillFile
+    void Spill(Transaction& tx)
+    {
+        const ImU64 spill_begin = SpillSize;
+        const size_t size = (size_t)(tx.DataEnd - tx.DataBegin);
+        if (!WriteSpill(Data.Data + (size_t)(tx.DataBegin - DataBase), size))
+        {
+            SpillSize = spill_begin;
+            return;
+        }
+        for (ImU64 n = tx.DeltaBegin; n < tx.DeltaEnd; n++)
+            GetDelta(n).Offset = GetDelta(n).Offset - tx.DataBegin + spill_begin;
+        Data.resize((int)(tx.DataBegin - DataBase));
+        tx.DataBegin = spill_begin;
+        tx.DataEnd = SpillSize;
+        tx.Spilled = true;
+    }
+
+    bool SeekSpill(ImU64 offset)
+    {
+#if defined(_MSC_VER) || defined(_UCRT)
+        return _fseeki64(SpillFile, (__int64)offset, SEEK_SET) == 0;
+#else
+        return fseeko(SpillFile, (off_t)offset, SEEK_SET) == 0;
+#endif
+    }
+
+    bool WriteSpill(const ImU8* data, size_t size)
+    {
+        if (SpillFile == NULL)
+            SpillFile = tmpfile();
+        if (SpillFile == NULL || !SeekSpill(SpillSize) || fwrite(data, 1, size, SpillFile) != size)
+            return false;
+        SpillSize += size;
+        return true;
+    }
+
+    // Run-length encoding: a varint token (len - 1) << 1 | is_run, followed by one byte (run) or 'len' bytes (literal).
+    // Only runs of 8 bytes or more are encoded as runs, so random data grows by a few bytes at most.
+    static size_t GetEncodeBound(size_t size) { return size + size / 2 + 16; }
+
+    static size_t GetRunLength(const ImU8* src, size_t size)
+    {
+        size_t n = 1;
+#ifdef IMGUI_MEMORY_EDITOR_SSE2
+        const __m128i v = _mm_set1_epi8((char)src[0]);
+        for (; n + 16 <= size; n += 16)
+        {
+            const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(const void*)(src + n)), v));
+            if (mask != 0xFFFF)
+                return n + (size_t)CountTrailingOnes(mask);
+        }
+#endif
+        while (n < size && src[n] == src[0])
+            n++;
+        return n;
+    }
+
+    static int CountTrailingOnes(int mask)
+    {
+        int n = 0;
+        while (mask & (1 << n))
+            n++;
+        return n;
+    }
+
+    static ImU8* EncodeToken(ImU8* out, size_t len, bool run)
+    {
+        size_t v = ((len - 1) << 1) | (run ? 1 : 0);
+        for (; v >= 0x80; v >>= 7)
+            *out++ = (ImU8)(v | 0x80);
+        *out++ = (ImU8)v;
+        return out;
+    }
+
+    static size_t EncodeRLE(const ImU8* src, size_t size, ImU8* out)
+    {
+        ImU8* out_start = out;
+        size_t literal_start = 0;
+        for (size_t n = 0; n < size; )
+        {
+            const size_t run = GetRunLength(src + n, size - n);
+            if (run < 8)
+            {
+                n += run;
+                continue;
+            }
+            if (literal_start < n)
+            {
+                out = EncodeToken(out, n - literal_start, false);
+                memcpy(out, src + literal_start, n - literal_start);
+                out += n - literal_start;
+            }
+            out = EncodeToken(out, run, true);
+            *out++ = src[n];
+            n += run;
+            literal_start = n;
+        }
+        if (literal_start < size)
+        {
+            out = EncodeToken(out, size - literal_start, false);
+            memcpy(out, src + literal_start, size - literal_start);
+            out += size - literal_start;
+        }
+        return (size_t)(out - out_start);
+    }
+
+    static bool DecodeRLE(const ImU8* src, size_t src_size, ImU8* out, size_t size)
+    {
+        const ImU8* src_end = src + src_size;
+        size_t n = 0;
+        while (src < src_end)
+        {
+            size_t v = 0;
+            for (int shift = 0; src < src_end; shift += 7)
+            {
+                v |= (size_t)(*src & 0x7F) << shift;
+                if ((*src++ & 0x80) == 0)
+                    break;
+            }
+            const size_t len = (v >> 1) + 1;
+            if (len > size - n || src >= src_end || (!(v & 1) && len > (size_t)(src_end - src)))
+                return false;
+            if (v & 1)
+            {
+                memset(out + n, *src, len);
+                src++;
+            }
+            else
+            {
+                memcpy(out + n, src, len);
+                src += len;
+            }
+            n += len;
+        }
+        return n == size;
+    }
+};
+
+// Interface for memory which isn't directly addressable through mem_data (other processes, devices, files..).
+// Set MemoryEditor::Source, or use the DrawWindow()/DrawContents() overloads taking a data source.
+struct MemoryEditorDataSource
+{
+    virtual ~MemoryEditorDataSource() {}
+    virtual size_t  GetSize() = 0;
+    virtual size_t  Read(size_t off, void* dst, size_t size) = 0;           // Return number of bytes read. A short read means the next byte is unreadable.
+    virtual size_t  GetUnreadableSize(size_t, size_t size) { return size; } // After a short read: return number of unreadable bytes at 'off' to skip (1..size) before reading again.
+    virtual size_t  Write(size_t, const void*, size_t) { return 0; }        // Return number of bytes written.
+
+    // Optional insertion/deletion, for sources which can change size (e.g. MemoryEditorFileSource).
+    virtual bool    IsResizable() { return false; }
+    virtual size_t  Insert(size_t, const void*, size_t) { return 0; }       // Insert bytes at 'off' (<= GetSize()). Return number of bytes inserted.
+    virtual size_t  Erase(size_t, size_t) { return 0; }                     // Return number of bytes erased.
+
+    // Optional address mapping, for sources which aren't contiguous (e.g. MemoryEditorSparseSource with gaps collapsed).
+    virtual size_t  GetAddr(size_t off) { return off; }                     // Return displayed address of 'off' (before base_display_addr).
+    virtual size_t  FindOffset(size_t addr) { return addr; }                // Return offset of displayed address 'addr', (size_t)-1 if none.
+
+    // Optional change tracking, used on refresh ticks (see MemoryEditor::RefreshRate) to only re-read memory which changed.
+    // When BeginChangeQuery() returns false all cached data is considered stale.
+    virtual bool    BeginChangeQuery() { return false; }
+    virtual bool    IsRangeChanged(size_t, size_t) { return true; }        // Return true if [off, off+size) may have changed since the previous query.
+    virtual void    EndChangeQuery() {}
+
+    // Background jobs (search, copy, export) read sources from worker threads while the UI thread may edit them. Jobs hold a LockScope
+    // around each read, and sources hold one while their layout or mapping changes (insertion, deletion, remapping, saving, closing).
+    // Reads made on the UI thread don't need it.
+    struct LockScope
+    {
+        MemoryEditorDataSource* Source;
+        LockScope(MemoryEditorDataSource* source) : Source(source) { if (Source) Source->LockJobs(); }
+        ~LockScope() { if (Source) Source->UnlockJobs(); }
+    };
+#ifndef IMGUI_MEMORY_EDITOR_NO_THREADS
+    std::recursive_mutex    JobMutex;
+    void            LockJobs()      { JobMutex.lock(); }
+    void            UnlockJobs()    { JobMutex.unlock(); }
+#else
+    void            LockJobs()      {}
+    void            UnlockJobs()    {}
+#endif
+};
+
+#ifdef IMGUI_MEMORY_EDITOR_POSIX
+// Memory of a live process, read through process_vm_readv().
+// Change tracking re-reads queried pages and compares them against a hash of their previous contents.
+// With OptSoftDirty, it uses the kernel soft-dirty bits instead (/proc/pid/pagemap), so only written pages are re-read. Each EndChangeQuery() then
+// writes "4" to /proc/pid/clear_refs, which clears soft-dirty bits of every page of the target process: don't use it on a process whose soft-dirty
+// bits are used by something else (CRIU incremental dumps, another tracker). Falls back to hashing when the target's pagemap can't be read
+// (needs ptrace access), clear_refs can't be written or the kernel has no CONFIG_MEM_SOFT_DIRTY.
+// Note that with OptSoftDirty, a write happening between IsRangeChanged() and EndChangeQuery() may be missed until the page is written again.
+struct MemoryEditorProcessSource : MemoryEditorDataSource
+{
+    struct PageHash
+    {
+        size_t  Off;
+        ImU64   Hash;
+    };
+
+    bool                OptSoftDirty;   // = false  // track changes with soft-dirty bits, see above. set before Open().
+    pid_t               Pid;
+    size_t              BaseAddr;       // address of offset 0 in the target process.
+    size_t              Size;
+    size_t              SysPageSize;
+    int                 PagemapFd;
+    int                 ClearRefsFd;
+    bool                SoftDirty;      // soft-dirty bits are used: OptSoftDirty and they are available for the target.
+    ImVector<PageHash>  PageHashes;     // fallback change tracking, sorted by Off.
+    ImVector<ImU8>      HashBuffer;
+
+    MemoryEditorProcessSource() { OptSoftDirty = false; Pid = 0; BaseAddr = Size = 0; SysPageSize = (size_t)sysconf(_SC_PAGESIZE); PagemapFd = ClearRefsFd = -1; SoftDirty = false; }
+    ~MemoryEditorProcessSource() { Close(); }
+
+    bool Open(pid_t pid, size_t base_addr, size_t size)
+    {
+        LockScope lock(this);
+        Close();
+        Pid = pid;
+        BaseAddr = base_addr;
+        Size = size;
+        if (OptSoftDirty)
+        {
+            // Probe the target: its pagemap entries must be readable (opening it isn't enough) and its clear_refs writable
+            char path[64];
+            ImSnprintf(path, sizeof(path), "/proc/%d/pagemap", (int)pid);
+            PagemapFd = open(path, O_RDONLY);
+            ImSnprintf(path, sizeof(path), "/proc/%d/clear_refs", (int)pid);
+            ClearRefsFd = open(path, O_WRONLY);
+            ImU64 entry = 0;
+            SoftDirty = (PagemapFd >= 0 && ClearRefsFd >= 0 && pread(PagemapFd, &entry, sizeof(entry), (off_t)(base_addr / SysPageSize * sizeof(entry))) == (ssize_t)sizeof(entry) && IsSoftDirtySupported());
+        }
+
+        // Check that the process is readable
+        ImU8 probe;
+        return size == 0 || Read(0, &probe, 1) == 1;
+    }
+
+    void Close()
+    {
+        LockScope lock(this);
+        if (PagemapFd >= 0)
+            close(PagemapFd);
+        if (ClearRefsFd >= 0)
+            close(ClearRefsFd);
+        PagemapFd = ClearRefsFd = -1;
+        SoftDirty = false;
+        PageHashes.clear();
+    }
+
+    // Verify soft-dirty bits are reported by the kernel (the target runs on the same one): write to a freshly mapped page of this process and check its pagemap entry.
+    // Bits are always clear without CONFIG_MEM_SOFT_DIRTY, and new pages are dirty otherwise: soft-dirty bits of this process are left untouched.
+    bool IsSoftDirtySupported() const
+    {
+        bool ret = false;
+        int pagemap_fd = open("/proc/self/pagemap", O_RDONLY);
+        void* probe = mmap(NULL, SysPageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (pagemap_fd >= 0 && probe != MAP_FAILED)
+        {
+            *(volatile ImU8*)probe = 1;
+            ImU64 entry = 0;
+            const size_t page_index = (size_t)probe / SysPageSize;
+            if (pread(pagemap_fd, &entry, sizeof(entry), (off_t)(page_index * sizeof(entry))) == (ssize_t)sizeof(entry))
+                ret = (entry & ((ImU64)1 << 55)) != 0;
+        }
+        if (probe != MAP_FAILED)
+            munmap(probe, SysPageSize);
+        if (pagemap_fd >= 0)
+            close(pagemap_fd);
+        return ret;
+    }
+
+    size_t GetSize() override { return Size; }
+
+    size_t Read(size_t off, void* dst, size_t size) override
+    {
+        return ReadProcessMemory(Pid, BaseAddr + off, dst, size, SysPageSize);
+    }
+
+    size_t GetUnreadableSize(size_t off, size_t size) override
+    {
+        const size_t page_remaining = SysPageSize - ((BaseAddr + off) & (SysPageSize - 1));
+        return (page_remaining < size) ? page_remaining : size;
+    }
+
+    // Read memory of a process (may be this process), stopping at the first unreadable page.
+    // The whole range is read with a single iovec. Since process_vm_readv() only guarantees partial reads at iovec granularity,
+    // after a short read we continue with one remote iovec per page to find the exact first unreadable page.
+    static size_t ReadProcessMemory(pid_t pid, size_t addr, void* dst, size_t size, size_t sys_page_size)
+    {
+        struct iovec local_iov = { dst, size };
+        struct iovec remote_iov[64];
+        remote_iov[0].iov_base = (void*)addr;
+        remote_iov[0].iov_len = size;
+        ssize_t ret = process_vm_readv(pid, &local_iov, 1, remote_iov, 1, 0);
+        size_t total = (ret < 0) ? 0 : (size_t)ret;
+        while (total < size)
+        {
+            int iov_count = 0;
+            size_t chunk = 0;
+            for (size_t a = addr + total; iov_count < IM_ARRAYSIZE(remote_iov) && total + chunk < size; iov_count++)
+            {
+                const size_t page_remaining = sys_page_size - (a & (sys_page_size - 1));
+                const size_t len = (page_remaining < size - total - chunk) ? page_remaining : size - total - chunk;
+                remote_iov[iov_count].iov_base = (void*)a;
+                remote_iov[iov_count].iov_len = len;
+                a += len;
+                chunk += len;
+            }
+            local_iov.iov_base = (ImU8*)dst + total;
+            local_iov.iov_len = chunk;
+            ret = process_vm_readv(pid, &local_iov, 1, remote_iov, (unsigned long)iov_count, 0);
+            if (ret <= 0)
+                break;
+            total += (size_t)ret;
+            if ((size_t)ret < chunk)
+                break;
+        }
+        return total;
+    }
+
+    size_t Write(size_t off, const void* src, size_t size) override
+    {
+        struct iovec local_iov = { (void*)src, size };
+        struct iovec remote_iov = { (void*)(BaseAddr + off), size };
+        ssize_t ret = process_vm_writev(Pid, &local_iov, 1, &remote_iov, 1, 0);
+        return (ret < 0) ? 0 : (size_t)ret;
+    }
+
+    bool BeginChangeQuery() override { return true; }
+
+    bool IsRangeChanged(size_t off, size_t size) override
+    {
+        if (size == 0)
+            return false;
+        if (SoftDirty)
+        {
+            // Soft-dirty: bit 55 of each 64-bit pagemap entry
+            const size_t page_min = (BaseAddr + off) / SysPageSize;
+            const size_t page_max = (BaseAddr + off + size - 1) / SysPageSize + 1;
+            ImU64 entries[64];
+            for (size_t page = page_min; page < page_max; page += IM_ARRAYSIZE(entries))
+            {
+                const size_t count = (page_max - page < (size_t)IM_ARRAYSIZE(entries)) ? page_max - page : (size_t)IM_ARRAYSIZE(entries);
+                if (pread(PagemapFd, entries, count * sizeof(ImU64), (off_t)(page * sizeof(ImU64))) != (ssize_t)(count * sizeof(ImU64)))
+                    return true;
+                for (size_t n = 0; n < count; n++)
+                    if (entries[n] & ((ImU64)1 << 55))
+                        return true;
+            }
+            return false;
+        }
+
+        // Fallback: re-read and compare hash (FNV-1a)
+        if (HashBuffer.Size < (int)size)
+            HashBuffer.resize((int)size);
+        const size_t read_size = Read(off, HashBuffer.Data, size);
+        ImU64 hash = 0xCBF29CE484222325ULL ^ read_size;
+        for (size_t n = 0; n < read_size; n++)
+            hash = (hash ^ HashBuffer.Data[n]) * 0x100000001B3ULL;
+        int lo = 0, hi = PageHashes.Size;
+        while (lo < hi)
+        {
+            int mid = (lo + hi) >> 1;
+            if (PageHashes.Data[mid].Off < off)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < PageHashes.Size && PageHashes.Data[lo].Off == off)
+        {
+            const bool changed = (PageHashes.Data[lo].Hash != hash);
+            PageHashes.Data[lo].Hash = hash;
+            return changed;
+        }
+        PageHash entry = { off, hash };
+        PageHashes.insert(PageHashes.Data + lo, entry);
+        return true;
+    }
+
+    void EndChangeQuery() override
+    {
+        if (SoftDirty && pwrite(ClearRefsFd, "4", 1, 0) != 1)
+            SoftDirty = false;
+    }
+};
+
+// Shared memory segment (POSIX shm object or SysV segment), mapped read-only by default. Reads are a memcpy from the mapping and never block the producer.
+// POSIX segments are checked for resize on each GetSize() (once per frame) and remapped. A segment shrinking while a frame is being drawn may still raise SIGBUS.
+// When SeqlockOffset is set, reads retry until the 32-bit sequence counter at that offset is even and unchanged across the copy, giving a consistent
+// snapshot of the visible rows (which MemoryEditor fetches with a single Read()). Only available on Linux with IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES defined.
+struct MemoryEditorSharedMemorySource : MemoryEditorDataSource
+{
+    ImU8*   Data;
+    size_t  Size;
+    int     Fd;                     // POSIX shm descriptor, or -1.
+    int     ShmId;                  // SysV segment id, or -1.
+    bool    Writable;
+    size_t  SeqlockOffset;          // = (size_t)-1 // offset of a 32-bit seqlock counter in the segment.
+    int     SeqlockMaxRetries;      // = 1000       // give up after this many retries, in which case SnapshotTorn is set.
+    std::atomic<bool> SnapshotTorn;         // last read was not a consistent snapshot.
+
+    MemoryEditorSharedMemorySource() { Data = NULL; Size = 0; Fd = ShmId = -1; Writable = false; SeqlockOffset = (size_t)-1; SeqlockMaxRetries = 1000; SnapshotTorn = false; }
+    ~MemoryEditorSharedMemorySource() { Close(); }
+
+    bool OpenPosix(const char* name, bool writable = false)
+    {
+        Close();
+        Writable = writable;
+        Fd = shm_open(name, writable ? O_RDWR : O_RDONLY, 0);
+        if (Fd < 0)
+            return false;
+        return Remap();
+    }
+
+    bool OpenSysV(int shm_id, bool writable = false)
+    {
+        LockScope lock(this);
+        Close();
+        struct shmid_ds ds;
+        if (shmctl(shm_id, IPC_STAT, &ds) != 0)
+            return false;
+        void* data = shmat(shm_id, NULL, writable ? 0 : SHM_RDONLY);
+        if (data == (void*)-1)
+            return false;
+        ShmId = shm_id;
+        Writable = writable;
+        Data = (ImU8*)data;
+        Size = (size_t)ds.shm_segsz;
+        return true;
+    }
+
+    void Close()
+    {
+        LockScope lock(this);
+        if (Fd >= 0 && Data != NULL)
+            munmap(Data, Size);
+        else if (ShmId >= 0 && Data != NULL)
+            shmdt(Data);
+        if (Fd >= 0)
+            close(Fd);
+        Data = NULL;
+        Size = 0;
+        Fd = ShmId = -1;
+    }
+
+    // POSIX: (re)map the object at its current size. Jobs reading the old mapping are waited for.
+    bool Remap()
+    {
+        LockScope lock(this);
+        struct stat st;
+        if (fstat(Fd, &st) != 0)
+            return false;
+        if (Data != NULL)
+            munmap(Data, Size);
+        Data = NULL;
+        Size = (size_t)st.st_size;
+        if (Size == 0)
+            return true;
+        void* data = mmap(NULL, Size, Writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, Fd, 0);
+        if (data == MAP_FAILED)
+        {
+            Size = 0;
+            return false;
+        }
+        Data = (ImU8*)data;
+        return true;
+    }
+
+    size_t GetSize() override
+    {
+        // SysV segments cannot be resized
+        struct stat st;
+        if (Fd >= 0 && fstat(Fd, &st) == 0 && (size_t)st.st_size != Size)
+            Remap();
+        return Size;
+    }
+
+    size_t Read(size_t off, void* dst, size_t size) override
+    {
+        if (off >= Size)
+            return 0;
+        if (size > Size - off)
+            size = Size - off;
+        if (SeqlockOffset == (size_t)-1 || SeqlockOffset + sizeof(ImU32) > Size)
+        {
+            memcpy(dst, Data + off, size);
+            return size;
+        }
+        ImU32* seq = (ImU32*)(void*)(Data + SeqlockOffset);
+        SnapshotTorn = true;
+        for (int attempt = 0; attempt <= SeqlockMaxRetries; attempt++)
+        {
+            const ImU32 seq_begin = __atomic_load_n(seq, __ATOMIC_ACQUIRE);
+            if (seq_begin & 1)
+                continue; // Write in progress
+            memcpy(dst, Data + off, size);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(seq, __ATOMIC_RELAXED) == seq_begin)
+            {
+                SnapshotTorn = false;
+                break;
+            }
+        }
+        return size;
+    }
+
+    size_t Write(size_t off, const void* src, size_t size) override
+    {
+        if (!Writable || off >= Size)
+            return 0;
+        if (size > Size - off)
+            size = Size - off;
+        memcpy(Data + off, src, size);
+        return size;
+    }
+};
+
+// Editable view of a file with insertion and deletion: a piece table over the original file (mmapped, never modified until saved) and an append buffer.
+// Pieces are kept in a treap (balanced binary tree) ordered by position, each node storing the length of its subtree, so offset lookups,
+// insertions and deletions are O(log n) regardless of file size. Overwrites of appended bytes are done in place.
+// Only available on Linux with IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES defined.
+struct MemoryEditorFileSource : MemoryEditorDataSource
+{
+    enum Buffer_ { Buffer_Original = 0, Buffer_Append = 1 };
+
+    struct Node
+    {
+        size_t  Offset;                 // in the buffer
+        size_t  Length;
+        size_t  SubtreeLength;          // Length of this node and its children
+        int     Left, Right;            // -1 if none
+        ImU32   Priority;               // parents have a higher priority than their children
+        int     Buffer;                 // Buffer_
+    };
+
+    struct Piece
+    {
+        int     Buffer;
+        size_t  Offset;
+        size_t  Length;
+        size_t  Pos;                    // position in the edited data
+    };
+
+    enum SyncMode_
+    {
+        SyncMode_None = 0,              // no sync: written data may be lost on a crash
+        SyncMode_Data,                  // fdatasync() written files
+        SyncMode_Full                   // fsync() written files, and their directory after a rename
+    };
+
+    struct SaveStats
+    {
+        size_t  BytesWritten;           // bytes written by write calls
+        size_t  BytesCopied;            // bytes copied by copy_file_range()
+        bool    Cloned;                 // the file was cloned (FICLONE)
+        SaveStats() { BytesWritten = BytesCopied = 0; Cloned = false; }
+    };
+
+    int             Fd;
+    ImVector<char>  Path;
+    bool            Writable;
+    const ImU8*     OriginalData;       // mmap of the file
+    size_t          OriginalSize;
+    ImVector<ImU8>  AppendBuffer;       // inserted/overwritten bytes
+    ImVector<Node>  Nodes;              // pool, unused nodes are in FreeNodes
+    ImVector<int>   FreeNodes;
+    int             Root;               // -1 if empty
+    ImU32           RandomState;
+    ImVector<int>   Stack;              // traversal stack
+    ImVector<ImU8>  WriteBuffer;
+    int             SyncMode;           // = SyncMode_Data // durability of Save()/SaveAs()
+    SaveStats       LastSave;
+
+    MemoryEditorFileSource() { Fd = -1; Writable = false; OriginalData = NULL; OriginalSize = 0; Root = -1; RandomState = 0x9E3779B9; SyncMode = SyncMode_Data; }
+    MemoryEditorFileSource(const MemoryEditorFileSource&) = delete;
+    MemoryEditorFileSource& operator=(const MemoryEditorFileSource&) = delete;
+    ~MemoryEditorFileSource() { Close(); }
+
+    bool Open(const char* path, bool writable = false)
+    {
+        LockScope lock(this);
+        Close();
+        Fd = open(path, writable ? O_RDWR : O_RDONLY);
+        if (Fd < 0)
+            return false;
+        Writable = writable;
+        Path.resize((int)strlen(path) + 1);
+        memcpy(Path.Data, path, (size_t)Path.Size);
+        if (!Remap())
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void Close()
+    {
+        LockScope lock(this);
+        if (OriginalData != NULL)
+            munmap((void*)OriginalData, OriginalSize);
+        if (Fd >= 0)
+            close(Fd);
+        Fd = -1;
+        OriginalData = NULL;
+        OriginalSize = 0;
+        ResetPieces();
+    }
+
+    // Map the file at its current size and discard edits
+    bool Remap()
+    {
+        LockScope lock(this);
+        if (OriginalData != NULL)
+            munmap((void*)OriginalData, OriginalSize);
+        OriginalData = NULL;
+        OriginalSize = 0;
+        ResetPieces();
+        struct stat st;
+        if (fstat(Fd, &st) != 0)
+            return false;
+        if (st.st_size > 0)
+        {
+            // MAP_SHARED: bytes written in place by Save() are visible through the mapping
+            void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, Fd, 0);
+            if (data == MAP_FAILED)
+                return false;
+            OriginalData = (const ImU8*)data;
+            OriginalSize = (size_t)st.st_size;
+            Root = NewNode(Buffer_Original, 0, OriginalSize);
+        }
+        return true;
+    }
+
+    bool IsModified() const
+    {
+        return Root == -1 ? OriginalSize != 0 : (Nodes[Root].Buffer != Buffer_Original || Nodes[Root].Offset != 0 || Nodes[Root].Length != OriginalSize || Nodes[Root].SubtreeLength != OriginalSize);
+    }
+
+    size_t GetSize() override { return Root == -1 ? 0 : Nodes[Root].SubtreeLength; }
+
+    size_t Read(size_t off, void* dst, size_t size) override
+    {
+        const size_t total = GetSize();
+        if (off >= total)
+            return 0;
+        if (size > total - off)
+            size = total - off;
+        for (size_t done = 0; done < size; )
+        {
+            size_t node_pos;
+            const Node& node = Nodes[FindNode(off + done, &node_pos)];
+            const size_t in_node = off + done - node_pos;
+            const size_t n = (node.Length - in_node < size - done) ? node.Length - in_node : size - done;
+            memcpy((ImU8*)dst + done, GetBufferData(node.Buffer) + node.Offset + in_node, n);
+            done += n;
+        }
+        return size;
+    }
+
+    // Overwrite: bytes of the append buffer are written in place, bytes of the original file are replaced by appended bytes.
+    size_t Write(size_t off, const void* src, size_t size) override
+    {
+        LockScope lock(this);
+        const size_t total = GetSize();
+        if (!Writable || off >= total)
+            return 0;
+        if (size > total - off)
+            size = total - off;
+        for (size_t done = 0; done < size; )
+        {
+            size_t node_pos;
+            const Node& node = Nodes[FindNode(off + done, &node_pos)];
+            const size_t in_node = off + done - node_pos;
+            const size_t n = (node.Length - in_node < size - done) ? node.Length - in_node : size - done;
+            if (node.Buffer == Buffer_Append)
+            {
+                memcpy(AppendBuffer.Data + node.Offset + in_node, (const ImU8*)src + done, n);
+            }
+            else
+            {
+                Erase(off + done, n);
+                Insert(off + done, (const ImU8*)src + done, n);
+            }
+            done += n;
+        }
+        return size;
+    }
+
+    bool IsResizable() override { return Writable; }
+
+    size_t Insert(size_t off, const void* src, size_t size) override
+    {
+        LockScope lock(this);
+        if (!Writable || off > GetSize() || size == 0)
+            return 0;
+        const size_t append_offset = (size_t)AppendBuffer.Size;
+        AppendBuffer.resize(AppendBuffer.Size + (int)size);
+        memcpy(AppendBuffer.Data + append_offset, src, size);
+
+        // Extend the previous piece when it ends with the last appended bytes (e.g. typing)
+        size_t prev_pos;
+        const int prev = (off > 0) ? FindNode(off - 1, &prev_pos) : -1;
+        if (prev != -1 && prev_pos + Nodes[prev].Length == off && Nodes[prev].Buffer == Buffer_Append && Nodes[prev].Offset + Nodes[prev].Length == append_offset)
+        {
+            for (int n = Root; ; )
+            {
+                Node& node = Nodes[n];
+                node.SubtreeLength += size;
+                if (n == prev)
+                {
+                    node.Length += size;
+                    break;
+                }
+                const size_t left_length = GetSubtreeLength(node.Left);
+                if (off - 1 < left_length)
+                {
+                    n = node.Left;
+                }
+                else
+                {
+                    off -= left_length + node.Length;
+                    n = node.Right;
+                }
+            }
+            return size;
+        }
+        int left, right;
+        Split(Root, off, &left, &right);
+        Root = Merge(Merge(left, NewNode(Buffer_Append, append_offset, size)), right);
+        return size;
+    }
+
+    size_t Erase(size_t off, size_t size) override
+    {
+        LockScope lock(this);
+        const size_t total = GetSize();
+        if (!Writable || off >= total)
+            return 0;
+        if (size > total - off)
+            size = total - off;
+        int left, middle, right;
+        Split(Root, off, &left, &right);
+        Split(right, size, &middle, &right);
+        FreeTree(middle);
+        Root = Merge(left, right);
+        return size;
+    }
+
+    // Return pieces in order
+    void GetPieces(ImVector<Piece>* out)
+    {
+        out->resize(0);
+        size_t pos = 0;
+        Stack.resize(0);
+        for (int n = Root; n != -1 || Stack.Size > 0; )
+        {
+            if (n != -1)
+            {
+                Stack.push_back(n);
+                n = Nodes[n].Left;
+                continue;
+            }
+            n = Stack.back();
+            Stack.pop_back();
+            Piece piece;
+            piece.Buffer = Nodes[n].Buffer;
+            piece.Offset = Nodes[n].Offset;
+            piece.Length = Nodes[n].Length;
+            piece.Pos = pos;
+            out->push_back(piece);
+            pos += piece.Length;
+            n = Nodes[n].Right;
+        }
+    }
+
+    // Write edits to the file. When the size didn't change and bytes of the original file weren't moved, only dirty pages are written in place.
+    // Else the data is written to a temporary file which replaces the original (see ReplaceFile()). Edits are then discarded and the file is mapped again.
+    bool Save()
+    {
+        LockScope lock(this);
+        LastSave = SaveStats();
+        if (!Writable || Fd < 0)
+            return false;
+        if (!IsModified())
+            return true;
+        ImVector<Piece> pieces;
+        GetPieces(&pieces);
+        if (IsLayoutUnchanged(pieces))
+        {
+            if (!WriteDirtyPages(Fd, pieces) || !SyncFile(Fd))
+                return false;
+            return Remap();
+        }
+        if (!ReplaceFile(Path.Data, pieces))
+            return false;
+        ImVector<char> path = Path;
+        return Open(path.Data, Writable);
+    }
+
+    // Write the edited data to another file, then edit that file. Saving to the open file itself (same device and inode) is a Save().
+    // Like the rest of the file source, Save()/SaveAs() and their copy_file_range()/FICLONE paths need IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES.
+    bool SaveAs(const char* path)
+    {
+        LockScope lock(this);
+        LastSave = SaveStats();
+        if (Fd < 0)
+            return false;
+        struct stat st, path_st;
+        if (fstat(Fd, &st) != 0)
+            return false;
+        if (stat(path, &path_st) == 0 && path_st.st_dev == st.st_dev && path_st.st_ino == st.st_ino)
+            return Save();
+        ImVector<Piece> pieces;
+        GetPieces(&pieces);
+        if (!ReplaceFile(path, pieces))
+            return false;
+        return Open(path, Writable);
+    }
+
+    // [Internal]
+    bool IsLayoutUnchanged(const ImVector<Piece>& pieces) const
+    {
+        if (GetSubtreeLength(Root) != OriginalSize)
+            return false;
+        for (const Piece& piece : pieces)
+            if (piece.Buffer == Buffer_Original && piece.Offset != piece.Pos)
+                return false;
+        return true;
+    }
+
+    // Write pages containing appended bytes to 'fd', which holds the original data. Adjacent dirty pages are written together.
+    bool WriteDirtyPages(int fd, const ImVector<Piece>& pieces)
+    {
+        const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+        const size_t total = GetSubtreeLength(Root);
+        size_t run_min = 0, run_max = 0;
+        for (int n = 0; n <= pieces.Size; n++)
+        {
+            if (n < pieces.Size && pieces[n].Buffer != Buffer_Append)
+                continue;
+            const size_t page_min = (n < pieces.Size) ? pieces[n].Pos & ~(page_size - 1) : (size_t)-1;
+            if (run_min < run_max && page_min > run_max)
+            {
+                if (!WriteEditedRange(fd, run_min, run_max))
+                    return false;
+                run_min = run_max = 0;
+            }
+            if (n == pieces.Size)
+                break;
+            const size_t piece_max = pieces[n].Pos + pieces[n].Length;
+            const size_t page_max = ((piece_max + page_size - 1) & ~(page_size - 1)) < total ? (piece_max + page_size - 1) & ~(page_size - 1) : total;
+            if (run_min == run_max)
+                run_min = page_min;
+            run_max = page_max;
+        }
+        return true;
+    }
+
+    // Write bytes [pos_min, pos_max) of the edited data at the same position in 'fd', 1 MB at a time
+    bool WriteEditedRange(int fd, size_t pos_min, size_t pos_max)
+    {
+        const size_t buf_size = 1024 * 1024;
+        WriteBuffer.resize((int)buf_size);
+        for (size_t pos = pos_min; pos < pos_max; pos += buf_size)
+        {
+            const size_t size = (pos_max - pos < buf_size) ? pos_max - pos : buf_size;
+            Read(pos, WriteBuffer.Data, size);
+            if (!WriteAll(fd, WriteBuffer.Data, size, pos))
+                return false;
+            LastSave.BytesWritten += size;
+        }
+        return true;
+    }
+
+    // Write the edited data to a new temporary file in the directory of 'path', then rename it to 'path'. The file at 'path' (which must not be
+    // the open file: its pages are still mapped) is only replaced once the data is completely written, and only the temporary file is removed on failure.
+    bool ReplaceFile(const char* path, const ImVector<Piece>& pieces)
+    {
+        struct stat st;
+        if (fstat(Fd, &st) != 0)
+            return false;
+        ImVector<char> temp_path;
+        temp_path.resize((int)strlen(path) + 16);
+        int out_fd = -1;
+        for (int attempt = 0; attempt < 100 && out_fd < 0; attempt++)
+        {
+            ImSnprintf(temp_path.Data, (size_t)temp_path.Size, "%s.tmp%d", path, attempt);
+            out_fd = open(temp_path.Data, O_WRONLY | O_CREAT | O_EXCL, st.st_mode & 0777);   // never reuse an existing file
+            if (out_fd < 0 && errno != EEXIST)
+                return false;
+        }
+        if (out_fd < 0)
+            return false;
+        if (!WriteFile(out_fd, pieces) || rename(temp_path.Data, path) != 0)
+        {
+            unlink(temp_path.Data);
+            return false;
+        }
+        if (SyncMode == SyncMode_Full)
+            SyncParentDirectory(path);
+        return true;
+    }
+
+    // Write the edited data to the new, empty file 'out_fd' and close it. When the layout is unchanged the original file is cloned (FICLONE, on filesystems
+    // supporting reflinks) and dirty pages are written over the clone. Else unchanged pieces are copied by the kernel with copy_file_range() (itself
+    // reflinked on some filesystems), and other pieces are gathered into 1 MB writes.
+    bool WriteFile(int out_fd, const ImVector<Piece>& pieces)
+    {
+        bool ok;
+#ifdef FICLONE
+        if (IsLayoutUnchanged(pieces) && ioctl(out_fd, FICLONE, Fd) == 0)
+        {
+            LastSave.Cloned = true;
+            ok = WriteDirtyPages(out_fd, pieces);
+        }
+        else
+#endif
+        {
+            ok = WritePieces(out_fd, pieces);
+        }
+        ok = ok && SyncFile(out_fd);
+        ok = (close(out_fd) == 0) && ok;
+        return ok;
+    }
+
+    bool WritePieces(int out_fd, const ImVector<Piece>& pieces)
+    {
+        const size_t buf_size = 1024 * 1024;
+        const size_t min_copy_size = 64 * 1024;     // smaller pieces of the original file are gathered with appended bytes
+        bool can_copy = true;
+        WriteBuffer.resize(0);
+        WriteBuffer.reserve((int)buf_size);
+        size_t file_pos = 0;
+        for (const Piece& piece : pieces)
+        {
+            const ImU8* data = GetBufferData(piece.Buffer) + piece.Offset;
+            const bool copy = can_copy && piece.Buffer == Buffer_Original && piece.Length >= min_copy_size;
+            if (!copy && (size_t)WriteBuffer.Size + piece.Length <= buf_size)
+            {
+                WriteBuffer.resize(WriteBuffer.Size + (int)piece.Length);
+                memcpy(WriteBuffer.Data + WriteBuffer.Size - piece.Length, data, piece.Length);
+                continue;
+            }
+            if (!WriteAll(out_fd, WriteBuffer.Data, (size_t)WriteBuffer.Size, file_pos))
+                return false;
+            LastSave.BytesWritten += (size_t)WriteBuffer.Size;
+            file_pos += (size_t)WriteBuffer.Size;
+            WriteBuffer.resize(0);
+            size_t copied = copy ? CopyFileRange(out_fd, piece.Offset, file_pos, piece.Length) : 0;
+            if (copy && copied < piece.Length)
+                can_copy = false; // unsupported (e.g. across filesystems): write the rest
+            LastSave.BytesCopied += copied;
+            if (!WriteAll(out_fd, data + copied, piece.Length - copied, file_pos + copied))
+                return false;
+            LastSave.BytesWritten += piece.Length - copied;
+            file_pos += piece.Length;
+        }
+        LastSave.BytesWritten += (size_t)WriteBuffer.Size;
+        return WriteAll(out_fd, WriteBuffer.Data, (size_t)WriteBuffer.Size, file_pos);
+    }
+
+    // Copy bytes of the original file to 'out_fd' in the kernel. Return number of bytes copied (less than 'size' when unsupported).
+    size_t CopyFileRange(int out_fd, size_t src_pos, size_t dst_pos, size_t size)
+    {
+        size_t copied = 0;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+        while (copied < size)
+        {
+            loff_t src_off = (loff_t)(src_pos + copied);
+            loff_t dst_off = (loff_t)(dst_pos + copied);
+            const ssize_t ret = copy_file_range(Fd, &src_off, out_fd, &dst_off, size - copied, 0);
+            if (ret <= 0)
+                break;
+            copied += (size_t)ret;
+        }
+#else
+        IM_UNUSED(out_fd); IM_UNUSED(src_pos); IM_UNUSED(dst_pos); IM_UNUSED(size);
+#endif
+        return copied;
+    }
+
+    bool SyncFile(int fd) const
+    {
+        if (SyncMode == SyncMode_None)
+            return true;
+        return (SyncMode == SyncMode_Data ? fdatasync(fd) : fsync(fd)) == 0;
+    }
+
+    // Make a rename durable
+    static void SyncParentDirectory(const char* path)
+    {
+        const char* slash = strrchr(path, '/');
+        char dir_path[1024];
+        if (slash == NULL)
+            ImSnprintf(dir_path, sizeof(dir_path), ".");
+        else
+            ImSnprintf(dir_path, sizeof(dir_path), "%.*s", (int)(slash - path + (slash == path ? 1 : 0)), path);
+        const int dir_fd = open(dir_path, O_RDONLY | O_DIRECTORY);
+        if (dir_fd >= 0)
+        {
+            fsync(dir_fd);
+            close(dir_fd);
+        }
+    }
+
+    static bool WriteAll(int fd, const ImU8* data, size_t size, size_t pos)
+    {
+        while (size > 0)
+        {
+            const ssize_t written = pwrite(fd, data, size, (off_t)pos);
+            if (written <= 0)
+                return false;
+            data += written;
+            pos += (size_t)written;
+            size -= (size_t)written;
+        }
+        return true;
+    }
+
+    const ImU8* GetBufferData(int buffer) const { return (buffer == Buffer_Original) ? OriginalData : AppendBuffer.Data; }
+    size_t      GetSubtreeLength(int n) const   { return (n == -1) ? 0 : Nodes[n].SubtreeLength; }
+    void        UpdateNode(int n)               { Nodes[n].SubtreeLength = GetSubtreeLength(Nodes[n].Left) + Nodes[n].Length + GetSubtreeLength(Nodes[n].Right); }
+
+    void ResetPieces()
+    {
+        Nodes.resize(0);
+        FreeNodes.resize(0);
+        AppendBuffer.resize(0);
+        Root = -1;
+    }
+
+    int NewNode(int buffer, size_t offset, size_t length)
+    {
+        int n;
+        if (FreeNodes.Size > 0)
+        {
+            n = FreeNodes.back();
+            FreeNodes.pop_back();
+        }
+        else
+        {
+            n = Nodes.Size;
+            Nodes.resize(Nodes.Size + 1);
+        }
+        RandomState ^= RandomState << 13; // xorshift32
+        RandomState ^= RandomState >> 17;
+        RandomState ^= RandomState << 5;
+        Node& node = Nodes[n];
+        node.Buffer = buffer;
+        node.Offset = offset;
+        node.Length = node.SubtreeLength = length;
+        node.Left = node.Right = -1;
+        node.Priority = RandomState;
+        return n;
+    }
+
+    void FreeTree(int n)
+    {
+        if (n == -1)
+            return;
+        FreeTree(Nodes[n].Left);
+        FreeTree(Nodes[n].Right);
+        FreeNodes.push_back(n);
+    }
+
+    // Return the node containing byte 'pos' (< GetSize()) and the position of its first byte
+    int FindNode(size_t pos, size_t* out_node_pos) const
+    {
+        size_t base = 0;
+        for (int n = Root; n != -1; )
+        {
+            const Node& node = Nodes[n];
+            const size_t left_length = GetSubtreeLength(node.Left);
+            if (pos < base + left_length)
+            {
+                n = node.Left;
+            }
+            else if (pos < base + left_length + node.Length)
+            {
+                *out_node_pos = base + left_length;
+                return n;
+            }
+            else
+            {
+                base += left_length + node.Length;
+                n = node.Right;
+            }
+        }
+        IM_ASSERT(0);
+        return -1;
+    }
+
+    // Split tree 'n' into the first 'pos' bytes and the rest, cutting a node in two if needed
+    void Split(int n, size_t pos, int* out_left, int* out_right)
+    {
+        if (n == -1)
+        {
+            *out_left = *out_right = -1;
+            return;
+        }
+        const size_t left_length = GetSubtreeLength(Nodes[n].Left);
+        if (pos <= left_length)
+        {
+            int right;
+            Split(Nodes[n].Left, pos, out_left, &right);
+            Nodes[n].Left = right;
+            UpdateNode(n);
+            *out_right = n;
+        }
+        else if (pos >= left_length + Nodes[n].Length)
+        {
+            int left;
+            Split(Nodes[n].Right, pos - left_length - Nodes[n].Length, &left, out_right);
+            Nodes[n].Right = left;
+            UpdateNode(n);
+            *out_left = n;
+        }
+        else
+        {
+            const size_t cut = pos - left_length;
+            const int tail = NewNode(Nodes[n].Buffer, Nodes[n].Offset + cut, Nodes[n].Length - cut); // may move Nodes[]
+            Nodes[n].Length = cut;
+            const int right = Nodes[n].Right;
+            Nodes[n].Right = -1;
+            UpdateNode(n);
+            *out_left = n;
+            *out_right = Merge(tail, right);
+        }
+    }
+
+    int Merge(int left, int right)
+    {
+        if (left == -1 || right == -1)
+            return (left == -1) ? right : left;
+        if (Nodes[left].Priority > Nodes[right].Priority)
+        {
+            const int merged = Merge(Nodes[left].Right, right);
+            Nodes[left].Right = merged;
+            UpdateNode(left);
+            return left;
+        }
+        const int merged = Merge(left, Nodes[right].Left);
+        Nodes[right].Left = merged;
+        UpdateNode(right);
+        return right;
+    }
+};
+
+// Write detection for memory of this process: watched pages are write-protected, the first write to a page is caught by a SIGSEGV handler
+// which marks the page dirty and makes it writable again. Rearm() takes the dirty flags and write-protects those pages again (called by MemoryEditor
+// at the start of each refresh, before re-reading them), IsRangeDirty() reports the flags taken by the last Rearm().
+// Watched memory must be regular read/write memory (heap/static data). Faults outside of watched pages are forwarded to the previous handler.
+// Only available on Linux with IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES defined.
+struct MemoryEditorWriteWatch
+{
+    enum { MaxWatches = 16 };
+
+    ImU8*           PageMin;            // first watched page (aligned)
+    size_t          PageCount;
+    size_t          SysPageSize;
+    std::atomic<ImU8>* DirtyPages;      // one flag per page, set from the signal handler.
+    ImU8*           RearmedPages;       // flags taken by the last Rearm().
+
+    MemoryEditorWriteWatch() { PageMin = NULL; PageCount = 0; SysPageSize = (size_t)sysconf(_SC_PAGESIZE); DirtyPages = NULL; RearmedPages = NULL; }
+    MemoryEditorWriteWatch(const MemoryEditorWriteWatch&) = delete;
+    MemoryEditorWriteWatch& operator=(const MemoryEditorWriteWatch&) = delete;
+    ~MemoryEditorWriteWatch() { Unwatch(); }
+
+    bool IsWatching() const { return DirtyPages != NULL; }
+
+    bool Watch(void* addr, size_t size)
+    {
+        Unwatch();
+        if (size == 0 || !InstallHandler())
+            return false;
+        std::atomic<MemoryEditorWriteWatch*>* watches = GetWatches();
+        int slot = 0;
+        while (slot < MaxWatches && watches[slot].load() != NULL)
+            slot++;
+        if (slot == MaxWatches)
+            return false;
+        PageMin = (ImU8*)((size_t)addr & ~(SysPageSize - 1));
+        PageCount = ((size_t)addr + size - (size_t)PageMin + SysPageSize - 1) / SysPageSize;
+        DirtyPages = (std::atomic<ImU8>*)IM_ALLOC(PageCount * sizeof(std::atomic<ImU8>));
+        for (size_t page = 0; page < PageCount; page++)
+            IM_PLACEMENT_NEW(&DirtyPages[page]) std::atomic<ImU8>((ImU8)1); // Everything is unknown until the first Rearm()
+        RearmedPages = (ImU8*)IM_ALLOC(PageCount);
+        memset(RearmedPages, 1, PageCount);
+        watches[slot].store(this);
+        return true;
+    }
+
+    void Unwatch()
+    {
+        if (DirtyPages == NULL)
+            return;
+        // Make pages writable first: a thread faulting meanwhile still finds the watch. Then wait for handlers which may still be reading it.
+        mprotect(PageMin, PageCount * SysPageSize, PROT_READ | PROT_WRITE);
+        std::atomic<MemoryEditorWriteWatch*>* watches = GetWatches();
+        for (int n = 0; n < MaxWatches; n++)
+            if (watches[n].load() == this)
+                watches[n].store(NULL);
+        while (GetHandlersInFlight().load() != 0)
+            sched_yield();
+        IM_FREE(DirtyPages);
+        IM_FREE(RearmedPages);
+        DirtyPages = NULL;
+        RearmedPages = NULL;
+        PageMin = NULL;
+        PageCount = 0;
+    }
+
+    // Return true if any page of [addr, addr+size) was written before the last Rearm() (and after the one before). Memory outside of the watch is always considered written.
+    bool IsRangeDirty(const void* addr, size_t size) const
+    {
+        if (DirtyPages == NULL || (const ImU8*)addr < PageMin || (const ImU8*)addr + size > PageMin + PageCount * SysPageSize)
+            return true;
+        const size_t page_min = ((const ImU8*)addr - PageMin) / SysPageSize;
+        const size_t page_max = ((const ImU8*)addr + size - 1 - PageMin) / SysPageSize;
+        for (size_t page = page_min; page <= page_max; page++)
+            if (RearmedPages[page])
+                return true;
+        return false;
+    }
+
+    // Take dirty flags (read by IsRangeDirty()) and write-protect dirty pages again. Data of those pages must be read after this call to not miss a write:
+    // a write after the flag was cleared either faults and sets it again, or happens before the page is protected and is seen by that read.
+    void Rearm()
+    {
+        for (size_t page = 0; page < PageCount; page++)
+        {
+            RearmedPages[page] = DirtyPages[page].exchange(0);
+            if (RearmedPages[page])
+                mprotect(PageMin + page * SysPageSize, SysPageSize, PROT_READ);
+        }
+    }
+
+    // [Internal]
+    static std::atomic<MemoryEditorWriteWatch*>* GetWatches()  { static std::atomic<MemoryEditorWriteWatch*> watches[MaxWatches]; return watches; }
+    static std::atomic<int>&        GetHandlersInFlight()       { static std::atomic<int> count(0); return count; }
+    static struct sigaction*        GetPrevAction()             { static struct sigaction prev_action; return &prev_action; }
+
+    static bool InstallHandler()
+    {
+        static bool installed = false;
+        if (installed)
+            return true;
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = SignalHandler;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        installed = (sigaction(SIGSEGV, &action, GetPrevAction()) == 0);
+        return installed;
+    }
+
+    // Only uses lock-free atomics and raw system calls. mprotect() isn't in the POSIX list of async-signal-safe functions, but on Linux it is
+    // a plain system call without user-space state: it is issued through syscall(), and errno is preserved for the interrupted code.
+    static void SignalHandler(int sig, siginfo_t* info, void* context)
+    {
+        ImU8* addr = (ImU8*)info->si_addr;
+        std::atomic<MemoryEditorWriteWatch*>* watches = GetWatches();
+        std::atomic<int>& in_flight = GetHandlersInFlight();
+        in_flight.fetch_add(1); // before loading watches: Unwatch() waits for it once the watch is removed
+        for (int n = 0; n < MaxWatches; n++)
+        {
+            MemoryEditorWriteWatch* watch = watches[n].load();
+            if (watch == NULL || addr < watch->PageMin || addr >= watch->PageMin + watch->PageCount * watch->SysPageSize)
+                continue;
+            const size_t page = (size_t)(addr - watch->PageMin) / watch->SysPageSize;
+            const int saved_errno = errno;
+            watch->DirtyPages[page].store(1);
+            syscall(SYS_mprotect, watch->PageMin + page * watch->SysPageSize, watch->SysPageSize, PROT_READ | PROT_WRITE);
+            errno = saved_errno;
+            in_flight.fetch_sub(1);
+            return;
+        }
+        in_flight.fetch_sub(1);
+
+        // Not ours: forward to previous handler, or restore default action and return to fault again.
+        struct sigaction* prev_action = GetPrevAction();
+        if ((prev_action->sa_flags & SA_SIGINFO) && prev_action->sa_sigaction != NULL)
+            prev_action->sa_sigaction(sig, info, context);
+        else if (prev_action->sa_handler != SIG_DFL && prev_action->sa_handler != SIG_IGN)
+            prev_action->sa_handler(sig);
+        else
+            signal(sig, SIG_DFL);
+    }
+};
+#endif // #ifdef IMGUI_MEMORY_EDITOR_POSIX
+
+// Background job: a resumable unit of work. StepFn() is called repeatedly until it returns true, each call doing a bounded amount of work
+// (e.g. scanning 64 KB) and updating ProgressDone/ProgressTotal. Cancellation is checked in-between steps (StepFn() may also poll CancelRequested).
+// The job is owned by the caller and must not be destroyed while IsBusy(): use MemoryEditorJobSystem::Wait().
+struct MemoryEditorJob
+{
+    enum Priority_
+    {
+        Priority_Interactive = 0,       // e.g. fetching visible rows: runs ahead of anything else.
+        Priority_Normal = 1,
+        Priority_Bulk = 2,              // e.g. full scans
+        Priority_COUNT
+    };
+
+    enum State_
+    {
+        State_Idle = 0,
+        State_Queued,
+        State_Running,
+        State_Done,
+        State_Cancelled,
+    };
+
+    bool                (*StepFn)(MemoryEditorJob* job);    // Do some work, return true when done.
+    void*               UserData;
+    int                 Priority;                           // Priority_
+    std::atomic<int>    State;                              // State_
+    std::atomic<bool>   CancelRequested;                    // Cancellation token.
+    std::atomic<ImU64>  ProgressDone;
+    std::atomic<ImU64>  ProgressTotal;
+
+    MemoryEditorJob() { StepFn = NULL; UserData = NULL; Priority = Priority_Normal; State = State_Idle; CancelRequested = false; ProgressDone = ProgressTotal = 0; }
+    MemoryEditorJob(const MemoryEditorJob& src) : MemoryEditorJob() { *this = src; }
+    MemoryEditorJob& operator=(const MemoryEditorJob& src)  // Only idle/finished jobs may be copied
+    {
+        IM_ASSERT(!IsBusy() && !src.IsBusy());
+        StepFn = src.StepFn; UserData = src.UserData; Priority = src.Priority; State = src.State.load(); CancelRequested = src.CancelRequested.load(); ProgressDone = src.ProgressDone.load(); ProgressTotal = src.ProgressTotal.load();
+        return *this;
+    }
+
+    bool    IsBusy() const          { const int state = State.load(std::memory_order_acquire); return state == State_Queued || state == State_Running; }
+    float   GetProgress() const     { const ImU64 total = ProgressTotal.load(); return total ? (float)((double)ProgressDone.load() / (double)total) : 0.0f; }
+    void    RequestCancel()         { CancelRequested = true; }
+
+    // Run one step. Return true when the job is finished (done or cancelled).
+    bool RunStep()
+    {
+        if (CancelRequested.load(std::memory_order_relaxed))
+        {
+            State.store(State_Cancelled, std::memory_order_release);
+            return true;
+        }
+        if (StepFn(this))
+        {
+            State.store(State_Done, std::memory_order_release);
+            return true;
+        }
+        return false;
+    }
+};
+
+#ifndef IMGUI_MEMORY_EDITOR_NO_THREADS
+// Worker pool shared by any number of MemoryEditor instances (set MemoryEditor::JobSystem), so the total number of threads is capped.
+// Each worker owns one queue per priority; jobs are submitted round-robin, workers pop from the front of their own queues and steal from
+// the back of other workers' queues. Higher priorities are always served first, and a running job is put back in its queue in-between
+// steps when a job of higher priority is waiting.
+struct MemoryEditorJobSystem
+{
+    struct Worker
+    {
+        std::thread                 Thread;
+        std::mutex                  Mutex;
+        ImVector<MemoryEditorJob*>  Queues[MemoryEditorJob::Priority_COUNT];
+    };
+
+    int                         MaxThreads;                 // = 4 // cap for Start().
+    ImVector<Worker*>           Workers;
+    std::mutex                  WakeMutex;
+    std::condition_variable     WakeCond;                   // signaled when jobs are submitted.
+    std::condition_variable     DoneCond;                   // signaled when a job finishes.
+    std::atomic<int>            QueuedCount[MemoryEditorJob::Priority_COUNT];
+    std::atomic<unsigned int>   NextWorker;
+    std::atomic<bool>           Quit;
+
+    MemoryEditorJobSystem() { MaxThreads = 4; for (int n = 0; n < MemoryEditorJob::Priority_COUNT; n++) QueuedCount[n] = 0; NextWorker = 0; Quit = false; }
+    ~MemoryEditorJobSystem() { Stop(); }
+
+    // Start worker threads. thread_count <= 0: number of hardware threads minus one. Always capped to MaxThreads.
+    void Start(int thread_count = 0)
+    {
+        Stop();
+        if (thread_count <= 0)
+            thread_count = (int)std::thread::hardware_concurrency() - 1;
+        if (thread_count > MaxThreads)
+            thread_count = MaxThreads;
+        if (thread_count < 1)
+            thread_count = 1;
+        Quit = false;
+        for (int n = 0; n < thread_count; n++)
+            Workers.push_back(IM_NEW(Worker)());
+        for (int n = 0; n < thread_count; n++)
+            Workers[n]->Thread = std::thread(&MemoryEditorJobSystem::WorkerMain, this, n);
+    }
+
+    // Stop worker threads. Queued jobs are cancelled.
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(WakeMutex);
+            Quit = true;
+        }
+        WakeCond.notify_all();
+        for (Worker* worker : Workers)
+            worker->Thread.join();
+        for (Worker* worker : Workers)
+        {
+            for (ImVector<MemoryEditorJob*>& queue : worker->Queues)
+                for (MemoryEditorJob* job : queue)
+                    job->State.store(MemoryEditorJob::State_Cancelled, std::memory_order_release);
+            IM_DELETE(worker);
+        }
+        Workers.clear();
+        for (int n = 0; n < MemoryEditorJob::Priority_COUNT; n++)
+            QueuedCount[n] = 0;
+        DoneCond.notify_all();
+    }
+
+    int GetThreadCount() const { return Workers.Size; }
+
+    void Submit(MemoryEditorJob* job)
+    {
+        IM_ASSERT(job->StepFn != NULL && !job->IsBusy() && Workers.Size > 0);
+        IM_ASSERT(job->Priority >= 0 && job->Priority < MemoryEditorJob::Priority_COUNT);
+        job->CancelRequested = false;
+        job->ProgressDone = 0;
+        Push(Workers[NextWorker++ % (unsigned int)Workers.Size], job, false);
+    }
+
+    // Request cancellation and wait for the job to stop.
+    void Cancel(MemoryEditorJob* job)
+    {
+        job->RequestCancel();
+        Wait(job);
+    }
+
+    void Wait(MemoryEditorJob* job)
+    {
+        std::unique_lock<std::mutex> lock(WakeMutex);
+        DoneCond.wait(lock, [job] { return !job->IsBusy(); });
+    }
+
+    // [Internal]
+    void Push(Worker* worker, MemoryEditorJob* job, bool front)
+    {
+        job->State.store(MemoryEditorJob::State_Queued, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(worker->Mutex);
+            ImVector<MemoryEditorJob*>& queue = worker->Queues[job->Priority];
+            if (front)
+                queue.insert(queue.Data, job);
+            else
+                queue.push_back(job);
+        }
+        {
+            std::lock_guard<std::mutex> lock(WakeMutex);
+            QueuedCount[job->Priority]++;
+        }
+        WakeCond.notify_one();
+    }
+
+    // Pop highest priority job: from the front of our own queue, else steal from the back of another worker's queue.
+    MemoryEditorJob* Pop(int worker_idx)
+    {
+        for (int priority = 0; priority < MemoryEditorJob::Priority_COUNT; priority++)
+        {
+            if (QueuedCount[priority].load() == 0)
+                continue;
+            for (int n = 0; n < Workers.Size; n++)
+            {
+                Worker* worker = Workers[(worker_idx + n) % Workers.Size];
+                std::lock_guard<std::mutex> lock(worker->Mutex);
+                ImVector<MemoryEditorJob*>& queue = worker->Queues[priority];
+                if (queue.Size == 0)
+                    continue;
+                MemoryEditorJob* job;
+                if (n == 0)
+                {
+                    job = queue.Data[0];
+                    queue.erase(queue.Data);
+                }
+                else
+                {
+                    job = queue.back();
+                    queue.pop_back();
+                }
+                QueuedCount[priority]--;
+                return job;
+            }
+        }
+        return NULL;
+    }
+
+    bool HasQueuedJobAbove(int priority) const
+    {
+        for (int n = 0; n < priority; n++)
+            if (QueuedCount[n].load() > 0)
+                return true;
+        return false;
+    }
+
+    void WorkerMain(int worker_idx)
+    {
+        while (!Quit)
+        {
+            MemoryEditorJob* job = Pop(worker_idx);
+            if (job == NULL)
+            {
+                std::unique_lock<std::mutex> lock(WakeMutex);
+                WakeCond.wait(lock, [this] { return Quit || HasQueuedJobAbove(MemoryEditorJob::Priority_COUNT); });
+                continue;
+            }
+            job->State.store(MemoryEditorJob::State_Running, std::memory_order_release);
+            for (;;)
+            {
+                if (job->RunStep())
+                {
+                    { std::lock_guard<std::mutex> lock(WakeMutex); }
+                    DoneCond.notify_all();
+                    break;
+                }
+                if (HasQueuedJobAbove(job->Priority) || Quit)
+                {
+                    // Yield to higher priority job
+                    Push(Workers[worker_idx], job, true);
+                    break;
+                }
+            }
+        }
+    }
+};
+#endif // #ifndef IMGUI_MEMORY_EDITOR_NO_THREADS
+
+// Optional pre-baked "00".."FF" glyphs (upper and lower case) added to a font, so each hex byte is drawn as one quad instead of two.
+// Call Build() once after adding fonts and before the renderer uploads the font texture. The atlas is rebuilt with the extra glyphs.
+// Glyphs are composed from the font's own digits, so output is pixel-identical. This requires a pixel-aligned font without oversampling
+// (e.g. the default ProggyClean font): Build() returns false otherwise and bytes are drawn as two glyphs.
+// Requires the custom rectangle API of ImGui < 1.92: with dynamic font atlases (1.92+), Build() returns false and bytes are drawn as text.
+struct MemoryEditorHexGlyphs
+{
+    ImFont*         Font;                   // font the glyphs were added to, NULL until Build() succeeded
+    ImWchar         CodepointBase;          // = 0xE000 // [base, base+256): "00".."FF", [base+256, base+512): "00".."ff". private use area by default.
+
+    MemoryEditorHexGlyphs() { Font = NULL; CodepointBase = 0xE000; }
+
+    // Return the codepoint drawing the two hex digits 'c0' 'c1', or 0.
+    ImWchar GetCodepoint(char c0, char c1) const
+    {
+        const char c[2] = { c0, c1 };
+        int value = 0, lower_case = 0;
+        for (int i = 0; i < 2; i++)
+        {
+            int nibble;
+            if (c[i] >= '0' && c[i] <= '9')         nibble = c[i] - '0';
+            else if (c[i] >= 'A' && c[i] <= 'F')    nibble = c[i] - 'A' + 10;
+            else if (c[i] >= 'a' && c[i] <= 'f')    { nibble = c[i] - 'a' + 10; lower_case = 1; }
+            else                                    return 0;
+            value = (value << 4) | nibble;
+        }
+        return (ImWchar)(CodepointBase + lower_case * 256 + value);
+    }
+
+    // Return true when the current font is the one the glyphs were baked for, at its native size.
+    bool IsUsable() const
+    {
+#if IMGUI_VERSION_NUM < 19200
+        return Font != NULL && ImGui::GetFont() == Font && ImGui::GetFontSize() == Font->FontSize;
+#else
+        return false;
+#endif
+    }
+
+#if IMGUI_VERSION_NUM < 19200
+    bool Build(ImFontAtlas* atlas, ImFont* font)
+    {
+        Font = NULL;
+        if (atlas->Locked || font == NULL)
+            return false;
+        if (!atlas->IsBuilt() && !atlas->Build())
+            return false;
+
+        // All digits must be pixel-aligned with one texel per pixel, so they can be copied side by side
+        const char* digits = "0123456789ABCDEFabcdef";
+        float advance = 0.0f, box_min_y = FLT_MAX, box_max_y = -FLT_MAX, box_min_x = FLT_MAX, box_max_x = -FLT_MAX;
+        for (const char* d = digits; *d; d++)
+        {
+            const ImFontGlyph* glyph = font->FindGlyphNoFallback((ImWchar)*d);
+            if (glyph == NULL || (advance != 0.0f && glyph->AdvanceX != advance) || !IsGlyphPixelAligned(atlas, glyph))
+                return false;
+            advance = glyph->AdvanceX;
+            if (glyph->X0 < box_min_x) box_min_x = glyph->X0;
+            if (glyph->X1 > box_max_x) box_max_x = glyph->X1;
+            if (glyph->Y0 < box_min_y) box_min_y = glyph->Y0;
+            if (glyph->Y1 > box_max_y) box_max_y = glyph->Y1;
+        }
+        if (advance != (float)(int)advance)
+            return false;
+
+        // Register and pack one rectangle per glyph pair, then copy digit pixels into them.
+        // Rectangles registered by a previous call for this font are reused, so calling Build() again doesn't grow the atlas.
+        const int rect_w = (int)(box_max_x - box_min_x + advance), rect_h = (int)(box_max_y - box_min_y);
+        int rect_ids[512];
+        const int rects_found = FindRects(atlas, font, rect_w, rect_h, rect_ids);
+        if (rects_found != 0 && rects_found != 512)
+            return false;
+        const int rects_count_before = atlas->CustomRects.Size;
+        const bool rects_added = (rects_found == 0);
+        if (rects_added)
+            for (int n = 0; n < 512; n++)
+                rect_ids[n] = atlas->AddCustomRectFontGlyph(font, (ImWchar)(CodepointBase + n), rect_w, rect_h, advance * 2, ImVec2(box_min_x, box_min_y));
+        bool packed = atlas->Build();   // releases and recreates the texture data itself
+        for (int n = 0; n < 512 && packed; n++)
+            packed = (rect_ids[n] >= 0) && atlas->GetCustomRectByIndex(rect_ids[n])->IsPacked();
+        if (!packed)
+        {
+            // Unregister our rectangles and rebuild without them, so the font doesn't keep glyphs pointing to unpacked rectangles
+            if (rects_added)
+            {
+                atlas->CustomRects.resize(rects_count_before);
+                atlas->Build();
+            }
+            return false;
+        }
+        unsigned char* pixels;
+        int tex_w, tex_h;
+        atlas->GetTexDataAsAlpha8(&pixels, &tex_w, &tex_h);
+        for (int n = 0; n < 512; n++)
+        {
+            const ImFontAtlasCustomRect* rect = atlas->GetCustomRectByIndex(rect_ids[n]);
+            for (int y = 0; y < rect->Height; y++)
+                memset(pixels + (size_t)(rect->Y + y) * tex_w + rect->X, 0, rect->Width);
+            const char* hex = (n < 256) ? "0123456789ABCDEF" : "0123456789abcdef";
+            for (int i = 0; i < 2; i++)
+            {
+                const ImFontGlyph* glyph = font->FindGlyphNoFallback((ImWchar)hex[i == 0 ? (n & 0xFF) >> 4 : n & 0x0F]);
+                const int src_x = (int)(glyph->U0 * tex_w + 0.5f), src_y = (int)(glyph->V0 * tex_h + 0.5f);
+                const int dst_x = rect->X + (int)(glyph->X0 - box_min_x + advance * i), dst_y = rect->Y + (int)(glyph->Y0 - box_min_y);
+                const int w = (int)(glyph->X1 - glyph->X0), h = (int)(glyph->Y1 - glyph->Y0);
+                for (int y = 0; y < h; y++)
+                    for (int x = 0; x < w; x++)
+                    {
+                        unsigned char& dst = pixels[(size_t)(dst_y + y) * tex_w + dst_x + x];
+                        const unsigned char src = pixels[(size_t)(src_y + y) * tex_w + src_x + x];
+                        dst = (src > dst) ? src : dst;
+                    }
+            }
+        }
+        if (atlas->TexPixelsRGBA32 != NULL)
+        {
+            // RGBA32 data was already converted from alpha: convert again in place, the buffer is owned by the atlas
+            for (size_t n = 0; n < (size_t)tex_w * tex_h; n++)
+                atlas->TexPixelsRGBA32[n] = IM_COL32(255, 255, 255, pixels[n]);
+        }
+        Font = font;
+        return true;
+    }
+#else
+    bool Build(ImFontAtlas*, ImFont*)
+    {
+        Font = NULL;
+        return false;
+    }
+#endif
+
+#if IMGUI_VERSION_NUM < 19200
+    // Fill 'rect_ids' with rectangles registered for our codepoints of 'font' by a previous Build(). Return their count, or -1 if their size differs.
+    int FindRects(ImFontAtlas* atlas, ImFont* font, int rect_w, int rect_h, int* rect_ids) const
+    {
+        int count = 0;
+        for (int n = 0; n < 512; n++)
+            rect_ids[n] = -1;
+        for (int i = 0; i < atlas->CustomRects.Size; i++)
+        {
+            const ImFontAtlasCustomRect& rect = atlas->CustomRects[i];
+            if (rect.Font != font || rect.GlyphID < (unsigned int)CodepointBase || rect.GlyphID >= (unsigned int)CodepointBase + 512)
+                continue;
+            if (rect.Width != rect_w || rect.Height != rect_h)
+                return -1;
+            rect_ids[rect.GlyphID - CodepointBase] = i;
+            count++;
+        }
+        return count;
+    }
+
+    // Return true when the glyph is at integer pixel offsets and texel coordinates, one texel per pixel.
+    static bool IsGlyphPixelAligned(const ImFontAtlas* atlas, const ImFontGlyph* glyph)
+    {
+        const float texels_w = (glyph->U1 - glyph->U0) * atlas->TexWidth, texels_h = (glyph->V1 - glyph->V0) * atlas->TexHeight;
+        const float values[] = { glyph->X0, glyph->Y0, glyph->X1, glyph->Y1, glyph->U0 * atlas->TexWidth, glyph->V0 * atlas->TexHeight, texels_w - (glyph->X1 - glyph->X0), texels_h - (glyph->Y1 - glyph->Y0) };
+        for (float v : values)
+        {
+            const float d = v - (float)(int)(v < 0.0f ? v - 0.5f : v + 0.5f);
+            if (d < -0.01f || d > 0.01f)
+                return false;
+        }
+        return glyph->Visible && texels_w - (glyph->X1 - glyph->X0) < 0.5f && texels_w - (glyph->X1 - glyph->X0) > -0.5f && texels_h - (glyph->Y1 - glyph->Y0) < 0.5f && texels_h - (glyph->Y1 - glyph->Y0) > -0.5f;
+    }
+#endif
+};
+
+// Data access, caching, search and formatting, usable without an ImGui context (headless tools, worker threads): only ImVector and
+// the IM_ macros of imgui.h are used. MemoryEditor is a view on top of it. Without a view, call UpdateCache() once per frame/iteration
+// before reading and RunTimeSlicedJobs() to advance jobs when no JobSystem threads are available.
+struct MemoryEditorEngine
+{
+    enum DataFormat
+    {
+        DataFormat_Bin = 0,
+        DataFormat_Dec = 1,
+        DataFormat_Hex = 2,
+        DataFormat_COUNT
+    };
+
+    // Access policy of a region of memory (default for memory outside of any region: read every frame)
+    enum RegionPolicy
+    {
+        RegionPolicy_Cacheable = 0,     // read once, then displayed from the cache until Refresh() is called.
+        RegionPolicy_Volatile = 1,      // re-read at the region refresh rate (or MemoryEditor::RefreshRate).
+        RegionPolicy_NeverRead = 2,     // reading has side-effects (FIFO, clear-on-read registers): never read implicitly, displayed as "--" until Refresh() is called.
+        RegionPolicy_COUNT
+    };
+
+    struct Region
+    {
+        size_t          Min, Max;       // [Min, Max) offsets relative to mem_data.
+        RegionPolicy    Policy;
+        float           RefreshRate;    // RegionPolicy_Volatile: number of reads per second (0.0f: every frame, <0.0f: use MemoryEditor::RefreshRate).
+        double          LastRefreshTime;
+    };
+
+    // State of a byte fetched for display/preview
+    enum ByteState
+    {
+        ByteState_Valid = 0,
+        ByteState_NotRead = 1,          // byte belongs to a RegionPolicy_NeverRead region and hasn't been refreshed.
+        ByteState_Unreadable = 2,       // byte couldn't be read (e.g. unmapped page).
+    };
+
+    // Text formats for copying ranges (see StartCopy())
+    enum TextFormat
+    {
+        TextFormat_Hex = 0,             // 0011aabb
+        TextFormat_HexDump = 1,         // address, hex and ascii columns, as displayed
+        TextFormat_CArray = 2,          // unsigned char data[4] = { 0x00, 0x11, 0xaa, 0xbb, };
+        TextFormat_Base64 = 3,
+        TextFormat_PythonBytes = 4,     // b'\x00\x11\xaa\xbb'
+        TextFormat_Xxd = 5,             // as output by xxd (with -o for the displayed address)
+        TextFormat_RustArray = 6,       // pub const DATA: [u8; 4] = [ 0x00, 0x11, 0xaa, 0xbb, ];
+        TextFormat_IntelHex = 7,        // 16 bytes records, displayed addresses truncated to 32-bit
+        TextFormat_SRecord = 8,         // Motorola S-record: S1/S2/S3 records depending on the highest address
+        TextFormat_Raw = 9,             // raw bytes, for exports only (not zero-terminated text)
+        TextFormat_COUNT
+    };
+
+    // Operations applied to a range with a key repeated over it (see ApplyTransform())
+    enum TransformOp
+    {
+        TransformOp_Fill = 0,           // replace with the key (e.g. "00" to zero a range, or a pattern)
+        TransformOp_Xor = 1,
+        TransformOp_And = 2,
+        TransformOp_Or = 3,
+        TransformOp_Add = 4,            // wrapping add, e.g. "ff" to subtract 1
+        TransformOp_RotateLeft = 5,     // rotate bits of each byte left by key & 7
+        TransformOp_COUNT
+    };
+
+    struct Transform
+    {
+        enum { KeyMaxSize = 32 };
+        TransformOp     Op;
+        int             KeySize;
+        ImU8            Key[KeyMaxSize];                        // Key[0] applies to the first byte of the range
+
+        Transform() { Op = TransformOp_Fill; KeySize = 1; memset(Key, 0, sizeof(Key)); }
+    };
+
+    // Background color for [Min, Max), drawn by every view of a SharedState.
+    struct HighlightRange
+    {
+        size_t          Min, Max;
+        ImU32           Color;
+    };
+
+    // State describing the viewed data rather than a view of it: page cache, access policy regions, highlight layers, undo history.
+    // By default each editor uses its own. Point the 'Shared' setting of several editors viewing the same data to one instance
+    // so data is read and cached once, whatever the number of views. Cache maintenance is done once per frame, by the first view drawn.
+    // Everything is keyed by offset from DataBase (offset in Source for views of a Source): views may show different parts of the data,
+    // or other memory altogether. Offsets of memory before DataBase wrap around (they are never covered by a region).
+    struct SharedState
+    {
+        const ImU8*     DataBase;                               // = NULL   // start of the data. NULL: mem_data of the first view drawn in each frame. set it when views show parts of one buffer, so offsets don't depend on drawing order.
+        MemoryEditorPageCache Cache;                            // bytes of cacheable/volatile/never-read regions, by offset
+        const ImU8*     CacheDataBase;                          // DataBase in use (NULL for views of a Source)
+        MemoryEditorDataSource* CacheSource;                    // Source of the views, NULL when they view memory
+        ImVector<Region> Regions;                               // access policy regions, sorted and non-overlapping. use AddRegion().
+        ImVector<HighlightRange> Highlights;                    // use AddHighlight()
+        HighlightRange  SearchMatch;                            // last match found by a view (Min == Max: none), highlighted by all views
+        bool            RefreshRequested;                       // set by Refresh(), applied on next frame
+        bool            RefreshReadAll;                         // during a refresh frame: allow reading RegionPolicy_NeverRead bytes
+        double          LastRefreshTime;                        // last time memory outside of regions was invalidated, when RefreshRate > 0.0f
+        int             LastUpdateFrame;                        // frame of last refresh request/volatile regions update
+        int             LastRefreshFrame;                       // frame of last invalidation of memory outside of regions
+        MemoryEditorMemoryBudget::Consumer CacheConsumer;       // Cache usage, when a MemoryBudget is set
+        MemoryEditorUndoJournal Journal;                        // undo/redo history of writes, by offset. a transaction is only undone by a view showing all its bytes.
+        MemoryEditorDataSource* JournalSource;                  // Source which Journal was recorded on (NULL: memory). history is only available to views of it.
+        MemoryEditorMemoryBudget::Consumer JournalConsumer;
+
+        SharedState() : CacheConsumer("Page cache", MemoryEditorMemoryBudget::EvictPriority_ColdPages, EvictCachePages), JournalConsumer("Undo history", MemoryEditorMemoryBudget::EvictPriority_Snapshots, EvictUndoHistory) { DataBase = CacheDataBase = NULL; CacheSource = JournalSource = NULL; SearchMatch.Min = SearchMatch.Max = 0; SearchMatch.Color = 0; RefreshRequested = RefreshReadAll = false; LastRefreshTime = -DBL_MAX; LastUpdateFrame = LastRefreshFrame = -1; }
+
+        static size_t EvictCachePages(MemoryEditorMemoryBudget::Consumer* consumer, size_t bytes)
+        {
+            MemoryEditorPageCache* cache = (MemoryEditorPageCache*)consumer->UserData;
+            const size_t released = cache->EvictColdPages(bytes);
+            consumer->Usage = cache->GetMemoryUsage();
+            return released;
+        }
+
+        static size_t EvictUndoHistory(MemoryEditorMemoryBudget::Consumer* consumer, size_t bytes)
+        {
+            MemoryEditorUndoJournal* journal = (MemoryEditorUndoJournal*)consumer->UserData;
+            size_t released = 0;
+            while (released < bytes && journal->Transactions.Size > 0 && journal->Depth == 0)
+                released += journal->DropOldest();
+            consumer->Usage = journal->GetMemoryUsage();
+            return released;
+        }
+
+        void AddHighlight(size_t addr_min, size_t addr_max, ImU32 color) { HighlightRange h; h.Min = addr_min; h.Max = addr_max; h.Color = color; Highlights.push_back(h); }
+        void ClearHighlights() { Highlights.clear(); }
+        bool HasHighlights() const { return Highlights.Size > 0 || SearchMatch.Min != SearchMatch.Max; }
+        const HighlightRange* FindHighlight(size_t addr) const
+        {
+            if (addr >= SearchMatch.Min && addr < SearchMatch.Max)
+                return &SearchMatch;
+            for (int n = Highlights.Size - 1; n >= 0; n--) // last added is drawn on top
+                if (addr >= Highlights[n].Min && addr < Highlights[n].Max)
+                    return &Highlights[n];
+            return NULL;
+        }
+        bool HasHighlightsIn(size_t addr_min, size_t addr_max) const
+        {
+            if (addr_max < addr_min) // wrapped around (view below CacheDataBase): don't bother
+                return HasHighlights();
+            if (SearchMatch.Min < addr_max && SearchMatch.Max > addr_min)
+                return true;
+            for (const HighlightRange& range : Highlights)
+                if (range.Min < addr_max && range.Max > addr_min)
+                    return true;
+            return false;
+        }
+    };
+
+    // Settings
+    float           RefreshRate;                                // = 0      // number of data reads per second for memory outside of regions (0.0f: every frame). in-between reads, rows are rendered from the cache.
+    ImU8            (*ReadFn)(const ImU8* data, size_t off);    // = 0      // optional handler to read bytes.
+    void            (*WriteFn)(ImU8* data, size_t off, ImU8 d); // = 0      // optional handler to write bytes.
+    MemoryEditorDataSource* Source;                             // = NULL   // optional data source. when set, reads/writes go through it and mem_data is ignored.
+#ifdef IMGUI_MEMORY_EDITOR_POSIX
+    MemoryEditorWriteWatch* WriteWatch;                         // = NULL   // optional write detection for mem_data (see MemoryEditorWriteWatch). on each refresh (every frame if RefreshRate == 0), only written pages are re-read.
+    bool            OptSafeReads;                               // = false  // read/write mem_data through process_vm_readv()/process_vm_writev(): unmapped pages are displayed as "??" instead of crashing. ignored with ReadFn/WriteFn. (IMGUI_MEMORY_EDITOR_ENABLE_POSIX_SOURCES only)
+#endif
+    SharedState*    Shared;                                     // = NULL   // optional state shared with other editors viewing the same data (cache, regions, highlights). NULL: use a private one.
+#ifndef IMGUI_MEMORY_EDITOR_NO_THREADS
+    MemoryEditorJobSystem* JobSystem;                           // = NULL   // worker pool for background jobs. share one between all instances to cap the total number of threads.
+#endif
+    float           JobTimeBudget;                              // = 2.0f   // milliseconds per frame spent running job steps inside DrawContents(), when JobSystem is NULL or has no threads.
+    MemoryEditorAllocator Allocator;                            //          // allocator for page cache blocks and frame buffers (default: ImGui::MemAlloc). editors sharing a SharedState should use the same.
+    MemoryEditorMemoryBudget* MemoryBudget;                     // = NULL   // optional memory budget shared by editors: cold cache pages and recomputable buffers are released when over budget. editors sharing a SharedState should use the same.
+    bool            OptUndo;                                    // = true   // record writes to mem_data in GetShared().Journal (see its MemoryCap/SpillThreshold settings). old bytes are read (from the cache when possible) before each write.
+    bool            OptUndoSources;                             // = false  // also record writes going through Source or WriteFn. off by default: reading old bytes may have side effects or be slow.
+
+    // [Internal State]
+    SharedState     LocalShared;                                // used when Shared == NULL
+    ImVector<MemoryEditorJob*> TimeSlicedJobs;                  // jobs run by RunTimeSlicedJobs()
+
+    // Byte pattern search, run as a job. Memory of RegionPolicy_NeverRead regions is skipped. Searches from StartAddr to the end then wraps around.
+    struct SearchState
+    {
+        enum { ChunkSize = 64 * 1024 };
+        MemoryEditorJob Job;
+        MemoryEditorEngine* Engine;
+        const ImU8*     MemData;
+        size_t          DataOffset;             // GetDataOffset(MemData)
+        size_t          MemSize;
+        size_t          StartAddr;
+        size_t          Cursor;                 // number of bytes scanned from StartAddr (wrapping)
+        size_t          ResultAddr;             // (size_t)-1 if not found
+        bool            ResultPending;          // set when finished, cleared once the editor navigated to the result
+        ImVector<ImU8>  Pattern;
+        ImVector<ImU8>  Buffer;
+        ImVector<ImU8>  BufferState;
+        MemoryEditorMemoryBudget::Consumer BufferConsumer;
+
+        SearchState() : BufferConsumer("Search buffers", MemoryEditorMemoryBudget::EvictPriority_Recomputable, EvictBuffers) { Engine = NULL; MemData = NULL; DataOffset = 0; MemSize = StartAddr = Cursor = 0; ResultAddr = (size_t)-1; ResultPending = false; Job.StepFn = Step; Job.Priority = MemoryEditorJob::Priority_Normal; }
+
+        static size_t EvictBuffers(MemoryEditorMemoryBudget::Consumer* consumer, size_t)
+        {
+            SearchState* search = (SearchState*)consumer->UserData;
+            if (search->Job.IsBusy())
+                return 0;
+            const size_t released = consumer->Usage;
+            search->Buffer.clear();
+            search->BufferState.clear();
+            consumer->Usage = 0;
+            return released;
+        }
+
+        static bool Step(MemoryEditorJob* job)
+        {
+            SearchState* search = (SearchState*)job->UserData;
+            const size_t pattern_size = (size_t)search->Pattern.Size;
+            if (search->Cursor >= search->MemSize || pattern_size == 0 || pattern_size > search->MemSize)
+                return true;
+
+            // Read a chunk plus pattern_size-1 bytes of overlap, not crossing the end of memory
+            const size_t addr = (search->StartAddr + search->Cursor) % search->MemSize;
+            size_t scan_size = ((size_t)ChunkSize < search->MemSize - search->Cursor) ? (size_t)ChunkSize : search->MemSize - search->Cursor;
+            if (scan_size > search->MemSize - addr)
+                scan_size = search->MemSize - addr;
+            const size_t read_size = (scan_size + pattern_size - 1 < search->MemSize - addr) ? scan_size + pattern_size - 1 : search->MemSize - addr;
+            if (search->Buffer.Size < (int)read_size)
+            {
+                search->Buffer.resize((int)read_size);
+                search->BufferState.resize((int)read_size);
+            }
+            search->Engine->ReadRangeUncached(search->MemData, search->DataOffset, addr, search->Buffer.Data, search->BufferState.Data, read_size);
+            const ImU8* data = search->Buffer.Data;
+            const ImU8* state = search->BufferState.Data;
+            for (size_t n = 0; n < scan_size && n + pattern_size <= read_size; n++)
+            {
+                const ImU8* p = (const ImU8*)memchr(data + n, search->Pattern[0], scan_size - n);
+                if (p == NULL)
+                    break;
+                n = (size_t)(p - data);
+                if (n + pattern_size > read_size || memcmp(p, search->Pattern.Data, pattern_size) != 0)
+                    continue;
+                bool valid = true;
+                for (size_t i = 0; i < pattern_size && valid; i++)
+                    valid = (state[n + i] == ByteState_Valid);
+                if (!valid)
+                    continue;
+                search->ResultAddr = addr + n;
+                return true;
+            }
+            search->Cursor += scan_size;
+            job->ProgressDone = search->Cursor;
+            return search->Cursor >= search->MemSize;
+        }
+    };
+    SearchState     Search;
+
+    // Copy of a range as text, run as a job. The text is encoded into a single buffer allocated upfront with its exact size.
+    struct CopyState
+    {
+        enum { ChunkSize = 64 * 1024 };
+        MemoryEditorJob Job;
+        MemoryEditorEngine* Engine;
+        const ImU8*     MemData;
+        size_t          DataOffset;             // GetDataOffset(MemData)
+        size_t          AddrMin, AddrMax;
+        size_t          Cursor;                 // next address to encode
+        TextFormat      Format;
+        int             Cols, AddrDigits, Flags;
+        size_t          BaseDisplayAddr;
+        char*           Text;                   // zero-terminated. call ReleaseText() once consumed.
+        MemoryEditorAllocator TextAllocator;
+        size_t          TextSize;
+        size_t          TextPos;
+        bool            ResultPending;          // set when started, cleared once the result was consumed
+        ImVector<ImU8>  Buffer;
+        ImVector<ImU8>  BufferState;
+
+        CopyState() { Engine = NULL; MemData = NULL; DataOffset = 0; AddrMin = AddrMax = Cursor = 0; Format = TextFormat_Hex; Cols = 16; AddrDigits = 8; Flags = 0; BaseDisplayAddr = 0; Text = NULL; TextSize = TextPos = 0; ResultPending = false; Job.StepFn = Step; Job.Priority = MemoryEditorJob::Priority_Normal; }
+        CopyState(const CopyState& src) : CopyState() { *this = src; }
+        CopyState& operator=(const CopyState& src) // only settings are copied
+        {
+            if (this == &src)
+                return *this;
+            ReleaseText();
+            Job = src.Job;
+            Format = src.Format; Cols = src.Cols; AddrDigits = src.AddrDigits; Flags = src.Flags;
+            return *this;
+        }
+        ~CopyState() { ReleaseText(); }
+
+        void ReleaseText()
+        {
+            if (Text)
+                TextAllocator.Free(Text, TextSize + 1);
+            Text = NULL;
+            TextSize = TextPos = 0;
+            ResultPending = false;
+            Buffer.clear();
+            BufferState.clear();
+        }
+
+        static bool Step(MemoryEditorJob* job)
+        {
+            CopyState* copy = (CopyState*)job->UserData;
+            const size_t chunk_size = (size_t)copy->Buffer.Size;
+            const size_t size = (copy->AddrMax - copy->Cursor < chunk_size) ? copy->AddrMax - copy->Cursor : chunk_size;
+            copy->Engine->ReadRangeUncached(copy->MemData, copy->DataOffset, copy->Cursor, copy->Buffer.Data, copy->BufferState.Data, size);
+            copy->TextPos += TextFormatEncode(copy->Format, copy->Buffer.Data, copy->BufferState.Data, size, copy->Cursor - copy->AddrMin, copy->AddrMax - copy->AddrMin, copy->BaseDisplayAddr + copy->Cursor, copy->Cols, copy->AddrDigits, copy->Flags, copy->Text + copy->TextPos);
+            copy->Cursor += size;
+            job->ProgressDone = copy->Cursor - copy->AddrMin;
+            if (copy->Cursor < copy->AddrMax)
+                return false;
+            IM_ASSERT(copy->TextPos == copy->TextSize);
+            copy->Text[copy->TextPos] = 0;
+            return true;
+        }
+    };
+    CopyState       Copy;
+
+    // Export of a range to a file, run as a job. Bytes are read and encoded 1 MB at a time, and each chunk is written with a single fwrite():
+    // memory use doesn't depend on the size of the range. Chunks go to a temporary file, renamed to the destination by the last step,
+    // or deleted by FinishExport() when cancelled or on error: an existing file at the destination is only replaced by a complete export.
+    struct ExportState
+    {
+        enum { ChunkSize = 1024 * 1024 };
+        MemoryEditorJob Job;
+        MemoryEditorEngine* Engine;
+        const ImU8*     MemData;
+        size_t          DataOffset;             // GetDataOffset(MemData)
+        size_t          AddrMin, AddrMax;
+        size_t          Cursor;                 // next address to encode
+        TextFormat      Format;
+        int             Cols, AddrDigits, Flags;
+        size_t          BaseDisplayAddr;
+        FILE*           File;
+        ImVector<char>  Path;                   // destination
+        ImVector<char>  TempPath;               // file being written, renamed to Path once complete
+        size_t          BytesWritten;           // to the file
+        bool            Failed;                 // file couldn't be written, or export was cancelled
+        bool            ResultPending;          // set when started, cleared by FinishExport()
+        ImVector<char>  Text;
+        ImVector<ImU8>  Buffer;
+        ImVector<ImU8>  BufferState;
+
+        ExportState() { Engine = NULL; MemData = NULL; DataOffset = 0; AddrMin = AddrMax = Cursor = 0; Format = TextFormat_Xxd; Cols = 16; AddrDigits = 8; Flags = 0; BaseDisplayAddr = 0; File = NULL; BytesWritten = 0; Failed = ResultPending = false; Job.StepFn = Step; Job.Priority = MemoryEditorJob::Priority_Bulk; }
+        ExportState(const ExportState& src) : ExportState() { *this = src; }
+        ExportState& operator=(const ExportState& src) // only settings are copied
+        {
+            if (this == &src)
+                return *this;
+            Job = src.Job;
+            Format = src.Format;
+            return *this;
+        }
+        ~ExportState() { CloseFile(false); }
+
+        // Create the temporary file next to the destination, without replacing an existing file
+        bool OpenFile()
+        {
+            TempPath.resize(Path.Size + 16);
+            for (int attempt = 0; attempt < 100 && File == NULL; attempt++)
+            {
+                ImSnprintf(TempPath.Data, (size_t)TempPath.Size, attempt ? "%s.tmp%d" : "%s.tmp", Path.Data, attempt);
+                File = fopen(TempPath.Data, "wbx");
+                if (File == NULL && errno != EEXIST)
+                    break;
+            }
+            return File != NULL;
+        }
+
+        // Close the file. A complete file replaces the destination, else it is deleted: the destination is untouched until then.
+        void CloseFile(bool complete)
+        {
+            if (File == NULL)
+                return;
+            if (fclose(File) != 0)
+                complete = false;
+            File = NULL;
+#ifdef _WIN32
+            if (complete && rename(TempPath.Data, Path.Data) != 0)
+                complete = (remove(Path.Data) == 0 && rename(TempPath.Data, Path.Data) == 0);   // rename() doesn't replace files on Windows
+#else
+            if (complete && rename(TempPath.Data, Path.Data) != 0)
+                complete = false;
+#endif
+            if (!complete)
+            {
+                remove(TempPath.Data);
+                Failed = true;
+            }
+        }
+
+        static bool Step(MemoryEditorJob* job)
+        {
+            ExportState* exp = (ExportState*)job->UserData;
+            const size_t chunk_size = (size_t)exp->Buffer.Size;
+            const size_t size = (exp->AddrMax - exp->Cursor < chunk_size) ? exp->AddrMax - exp->Cursor : chunk_size;
+            exp->Engine->ReadRangeUncached(exp->MemData, exp->DataOffset, exp->Cursor, exp->Buffer.Data, exp->BufferState.Data, size);
+
+            const size_t offset = exp->Cursor - exp->AddrMin;
+            const size_t text_size = TextFormatCalcSize(exp->Format, size, offset, exp->AddrMax - exp->AddrMin, exp->BaseDisplayAddr + exp->Cursor, exp->Cols, exp->AddrDigits);
+            if ((size_t)exp->Text.Size < text_size)
+                exp->Text.resize((int)text_size);
+            const size_t text_written = TextFormatEncode(exp->Format, exp->Buffer.Data, exp->BufferState.Data, size, offset, exp->AddrMax - exp->AddrMin, exp->BaseDisplayAddr + exp->Cursor, exp->Cols, exp->AddrDigits, exp->Flags, exp->Text.Data);
+            IM_ASSERT(text_written == text_size);
+            IM_UNUSED(text_written);
+            if (fwrite(exp->Text.Data, 1, text_size, exp->File) != text_size)
+            {
+                exp->CloseFile(false);
+                return true;
+            }
+            exp->BytesWritten += text_size;
+            exp->Cursor += size;
+            job->ProgressDone = exp->Cursor - exp->AddrMin;
+            if (exp->Cursor < exp->AddrMax)
+                return false;
+            exp->CloseFile(true);
+            return true;
+        }
+    };
+    ExportState     Export;
+
+    MemoryEditorEngine()
+    {
+        RefreshRate = 0.0f;
+        ReadFn = NULL;
+        WriteFn = NULL;
+        Source = NULL;
+#ifdef IMGUI_MEMORY_EDITOR_POSIX
+        WriteWatch = NULL;
+        OptSafeReads = false;
+#endif
+        Shared = NULL;
+#ifndef IMGUI_MEMORY_EDITOR_NO_THREADS
+        JobSystem = NULL;
+#endif
+        JobTimeBudget = 2.0f;
+        MemoryBudget = NULL;
+        OptUndo = true;
+        OptUndoSources = false;
+    }
+    ~MemoryEditorEngine() { CancelJob(&Search.Job); CancelJob(&Copy.Job); CancelJob(&Export.Job); }
+
+    SharedState&        GetShared()         { return Shared ? *Shared : LocalShared; }
+    const SharedState&  GetShared() const   { return Shared ? *Shared : LocalShared; }
+
+    // Offset of byte 0 of mem_data in the shared data (see SharedState::DataBase). Add it to view addresses to index the cache, regions, highlights and undo history.
+    // Until the first UpdateCache() without DataBase, offsets are relative to mem_data.
+    size_t GetDataOffset(const void* mem_data) const
+    {
+        const SharedState& shared = GetShared();
+        const ImU8* data_base = shared.CacheDataBase ? shared.CacheDataBase : shared.DataBase;
+        return (Source || data_base == NULL) ? 0 : (size_t)((uintptr_t)mem_data - (uintptr_t)data_base);
+    }
+
+    // Declare an access policy for [addr_min, addr_max) (offsets from SharedState::DataBase: relative to mem_data for views of the whole data). Replaces the policy of any overlapping part of existing regions.
+    void AddRegion(size_t addr_min, size_t addr_max, RegionPolicy policy, float refresh_rate = -1.0f)
+    {
+        IM_ASSERT(addr_min < addr_max && policy >= 0 && policy < RegionPolicy_COUNT);
+        ImVector<Region>& regions = GetShared().Regions;
+        for (int n = 0; n < regions.Size; n++)
+        {
+            Region& r = regions[n];
+            if (r.Max <= addr_min || r.Min >= addr_max)
+                continue;
+            if (r.Min < addr_min && r.Max > addr_max)
+            {
+                // Split existing region in two
+                Region tail = r;
+                tail.Min = addr_max;
+                r.Max = addr_min;
+                regions.insert(regions.Data + n + 1, tail);
+                n++;
+            }
+            else if (r.Min < addr_min) { r.Max = addr_min; }
+            else if (r.Max > addr_max) { r.Min = addr_max; }
+            else { regions.erase(regions.Data + n); n--; }
+        }
+        Region region;
+        region.Min = addr_min;
+        region.Max = addr_max;
+        region.Policy = policy;
+        region.RefreshRate = refresh_rate;
+        region.LastRefreshTime = -DBL_MAX;
+        int n = 0;
+        while (n < regions.Size && regions[n].Min < addr_min)
+            n++;
+        regions.insert(regions.Data + n, region);
+        GetShared().Cache.Invalidate(addr_min, addr_max - addr_min);
+    }
+
+    void ClearRegions()
+    {
+        GetShared().Regions.clear();
+        GetShared().Cache.Clear();
+    }
+
+    // Start a job: submitted to JobSystem when it has threads, otherwise run by RunTimeSlicedJobs() (called by MemoryEditor::DrawContents() with JobTimeBudget).
+    void StartJob(MemoryEditorJob* job)
+    {
+#ifndef IMGUI_MEMORY_EDITOR_NO_THREADS
+        if (JobSystem && JobSystem->GetThreadCount() > 0)
+        {
+            JobSystem->Submit(job);
+            return;
+        }
+#endif
+        IM_ASSERT(job->StepFn != NULL && !job->IsBusy());
+        job->CancelRequested = false;
+        job->ProgressDone = 0;
+        job->State = MemoryEditorJob::State_Queued;
+        TimeSlicedJobs.push_back(job);
+    }
+
+    // Cancel a job and wait for it to stop.
+    void CancelJob(MemoryEditorJob* job)
+    {
+        for (int n = 0; n < TimeSlicedJobs.Size; n++)
+            if (TimeSlicedJobs[n] == job)
+            {
+                TimeSlicedJobs.erase(TimeSlicedJobs.Data + n);
+                job->State = MemoryEditorJob::State_Cancelled;
+                return;
+            }
+#ifndef IMGUI_MEMORY_EDITOR_NO_THREADS
+        if (JobSystem && job->IsBusy())
+            JobSystem->Cancel(job);
+#endif
+    }
+
+    // Run steps of time-sliced jobs, highest priority first, until 'budget_ms' is spent. Progress carries over to next call.
+    void RunTimeSlicedJobs(float budget_ms)
+    {
+        const std::chrono::steady_clock::time_point time_end = std::chrono::steady_clock::now() + std::chrono::microseconds((long long)(budget_ms * 1000.0f));
+        while (TimeSlicedJobs.Size > 0)
+        {
+            int job_n = 0;
+            for (int n = 1; n < TimeSlicedJobs.Size; n++)
+                if (TimeSlicedJobs[n]->Priority < TimeSlicedJobs[job_n]->Priority)
+                    job_n = n;
+            MemoryEditorJob* job = TimeSlicedJobs[job_n];
+            job->State = MemoryEditorJob::State_Running;
+            if (job->RunStep())
+                TimeSlicedJobs.erase(TimeSlicedJobs.Data + job_n);
+            else
+                job->State = MemoryEditorJob::State_Queued;
+            if (std::chrono::steady_clock::now() >= time_end)
+                break;
+        }
+    }
+
+    // Search 'pattern' starting from 'start_addr', wrapping around. Result in Search.ResultAddr once Search.Job is done (MemoryEditor highlights and scrolls to it).
+    void StartSearch(const void* mem_data, size_t mem_size, size_t start_addr, const ImU8* pattern, size_t pattern_size)
+    {
+        CancelJob(&Search.Job);
+        Search.Engine = this;
+        Search.Job.UserData = &Search;   // not set once in SearchState(): would point to the original after a copy
+        Search.MemData = (const ImU8*)mem_data;
+        Search.DataOffset = GetDataOffset(mem_data);
+        Search.MemSize = mem_size;
+        Search.StartAddr = (start_addr < mem_size) ? start_addr : 0;
+        Search.Cursor = 0;
+        Search.ResultAddr = (size_t)-1;
+        Search.ResultPending = true;
+        Search.Pattern.resize((int)pattern_size);
+        memcpy(Search.Pattern.Data, pattern, pattern_size);
+        Search.Job.ProgressTotal = mem_size;
+        StartJob(&Search.Job);
+    }
+
+    // Copy [addr_min, addr_max) as text. Once Copy.Job is done, the text is in Copy.Text (MemoryEditor puts it in the clipboard, then calls Copy.ReleaseText()).
+    // 'addr_digits', 'cols' and 'base_display_addr' are used by TextFormat_HexDump, 'flags' accepts RowFormatFlags_UpperCaseHex.
+    void StartCopy(const void* mem_data, size_t addr_min, size_t addr_max, TextFormat format, int cols, int addr_digits, size_t base_display_addr, int flags)
+    {
+        IM_ASSERT(addr_min < addr_max && format >= 0 && format < TextFormat_Raw);
+        CancelJob(&Copy.Job);
+        Copy.ReleaseText();
+        Copy.Engine = this;
+        Copy.Job.UserData = &Copy;
+        Copy.MemData = (const ImU8*)mem_data;
+        Copy.DataOffset = GetDataOffset(mem_data);
+        Copy.AddrMin = Copy.Cursor = addr_min;
+        Copy.AddrMax = addr_max;
+        Copy.Format = format;
+        Copy.Cols = (cols > 0) ? cols : 16;
+        Copy.AddrDigits = addr_digits;
+        Copy.Flags = flags;
+        Copy.BaseDisplayAddr = base_display_addr;
+        Copy.TextSize = TextFormatCalcSize(format, addr_max - addr_min, base_display_addr + addr_min, Copy.Cols, addr_digits);
+        Copy.TextPos = 0;
+        Copy.TextAllocator = Allocator;
+        Copy.Text = (char*)Allocator.Alloc(Copy.TextSize + 1);
+        Copy.ResultPending = true;
+
+        // Chunks hold whole lines/groups, so each one can be encoded on its own
+        const size_t unit = TextFormatGetUnitSize(format, Copy.Cols);
+        size_t chunk_size = (CopyState::ChunkSize > unit) ? (CopyState::ChunkSize / unit) * unit : unit;
+        if (chunk_size > addr_max - addr_min)
+            chunk_size = addr_max - addr_min;
+        Copy.Buffer.resize((int)chunk_size);
+        Copy.BufferState.resize((int)chunk_size);
+        Copy.Job.ProgressTotal = addr_max - addr_min;
+        StartJob(&Copy.Job);
+    }
+
+    // Export [addr_min, addr_max) to a file in any TextFormat. Return false if the file can't be created. Progress is in Export.Job,
+    // once done call FinishExport() (MemoryEditor does it): Export.Failed tells if the file was completely written.
+    bool StartExport(const void* mem_data, size_t addr_min, size_t addr_max, TextFormat format, const char* path, int cols, int addr_digits, size_t base_display_addr, int flags)
+    {
+        IM_ASSERT(addr_min < addr_max && format >= 0 && format < TextFormat_COUNT);
+        CancelJob(&Export.Job);
+        FinishExport();
+        Export.Path.resize((int)strlen(path) + 1);
+        memcpy(Export.Path.Data, path, (size_t)Export.Path.Size);
+        Export.Failed = !Export.OpenFile();
+        if (Export.Failed)
+            return false;
+        setvbuf(Export.File, NULL, _IONBF, 0); // chunks are written at once
+        Export.Engine = this;
+        Export.Job.UserData = &Export;
+        Export.MemData = (const ImU8*)mem_data;
+        Export.DataOffset = GetDataOffset(mem_data);
+        Export.AddrMin = Export.Cursor = addr_min;
+        Export.AddrMax = addr_max;
+        Export.Format = format;
+        Export.Cols = (cols > 0) ? cols : 16;
+        Export.AddrDigits = addr_digits;
+        Export.Flags = flags;
+        Export.BaseDisplayAddr = base_display_addr;
+        Export.BytesWritten = 0;
+        Export.ResultPending = true;
+
+        // Chunks hold whole lines/records, so each one can be encoded on its own
+        const size_t unit = TextFormatGetUnitSize(format, Export.Cols);
+        size_t chunk_size = (ExportState::ChunkSize > unit) ? (ExportState::ChunkSize / unit) * unit : unit;
+        if (chunk_size > addr_max - addr_min)
+            chunk_size = addr_max - addr_min;
+        Export.Buffer.resize((int)chunk_size);
+        Export.BufferState.resize((int)chunk_size);
+        Export.Job.ProgressTotal = addr_max - addr_min;
+        StartJob(&Export.Job);
+        return true;
+    }
+
+    // Release export buffers, and delete the file of a cancelled export
+    void FinishExport()
+    {
+        IM_ASSERT(!Export.Job.IsBusy());
+        Export.CloseFile(false);
+        Export.ResultPending = false;
+        Export.Text.clear();
+        Export.Buffer.clear();
+        Export.BufferState.clear();
+    }
+
+    // Read [addr, addr+size) for background jobs: bypass the cache (not thread-safe) but honor RegionPolicy_NeverRead.
+    // Source is locked, so it can't be edited, remapped or saved by the UI thread meanwhile. 'data_offset' is GetDataOffset(mem_data), taken when the job started.
+    void ReadRangeUncached(const ImU8* mem_data, size_t data_offset, size_t addr, ImU8* out_data, ImU8* out_state, size_t size) const
+    {
+        MemoryEditorDataSource::LockScope lock(Source);
+        while (size > 0)
+        {
+            const Region* region;
+            const size_t run = FindRegionRun(data_offset + addr, size, &region);
+            if (region && region->Policy == RegionPolicy_NeverRead)
+            {
+                memset(out_data, 0, run);
+                memset(out_state, ByteState_NotRead, run);
+            }
+            else
+            {
+                ReadDirect(mem_data, addr, out_data, out_state, run);
+            }
+            addr += run;
+            out_data += run;
+            out_state += run;
+            size -= run;
+        }
+    }
+
+    // Re-read all cached bytes on next frame, including visible bytes of RegionPolicy_NeverRead regions.
+    void Refresh()
+    {
+        GetShared().RefreshRequested = true;
+    }
+
+    // Return the region containing offset 'addr' or NULL. When NULL, '*out_next_min' is set to the start of the next region, or to 0 when there's none (offsets wrap there).
+    const Region* FindRegion(size_t addr, size_t* out_next_min) const
+    {
+        const ImVector<Region>& regions = GetShared().Regions;
+        int lo = 0, hi = regions.Size;
+        while (lo < hi)
+        {
+            int mid = (lo + hi) >> 1;
+            if (regions.Data[mid].Max <= addr)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < regions.Size && regions.Data[lo].Min <= addr)
+            return &regions.Data[lo];
+        *out_next_min = (lo < regions.Size) ? regions.Data[lo].Min : 0;
+        return NULL;
+    }
+
+    // Number of bytes from offset 'off' (at most 'size') which share '*out_region': up to the end of the region, or to the next one.
+    size_t FindRegionRun(size_t off, size_t size, const Region** out_region) const
+    {
+        size_t next_region_min = 0;
+        *out_region = FindRegion(off, &next_region_min);
+        const size_t run = *out_region ? (*out_region)->Max - off : next_region_min - off;
+        return (run == 0 || run > size) ? size : run; // 0: no region at all
+    }
+
+    // Read directly from target memory, bypassing access policies.
+    void ReadDirect(const ImU8* mem_data, size_t addr, ImU8* out_data, ImU8* out_state, size_t size) const
+    {
+        if (Source)
+        {
+            while (size > 0)
+            {
+                // Read until a short read, then skip unreadable bytes
+                const size_t read_size = Source->Read(addr, out_data, size);
+                memset(out_state, ByteState_Valid, read_size);
+                if (read_size >= size)
+                    break;
+                size_t skip_size = Source->GetUnreadableSize(addr + read_size, size - read_size);
+                skip_size = (skip_size < 1) ? 1 : (skip_size > size - read_size) ? size - read_size : skip_size;
+                memset(out_data + read_size, 0, skip_size);
+                memset(out_state + read_size, ByteState_Unreadable, skip_size);
+                addr += read_size + skip_size;
+                out_data += read_size + skip_size;
+                out_state += read_size + skip_size;
+                size -= read_size + skip_size;
+            }
+            return;
+        }
+        if (ReadFn)
+            for (size_t n = 0; n < size; n++)
+                out_data[n] = ReadFn(mem_data, addr + n);
+#ifdef IMGUI_MEMORY_EDITOR_POSIX
+        else if (OptSafeReads)
+        {
+            const size_t sys_page_size = (size_t)sysconf(_SC_PAGESIZE);
+            while (size > 0)
+            {
+                const size_t read_size = MemoryEditorProcessSource::ReadProcessMemory(getpid(), (size_t)(mem_data + addr), out_data, size, sys_page_size);
+                memset(out_state, ByteState_Valid, read_size);
+                if (read_size >= size)
+                    break;
+                const size_t page_remaining = sys_page_size - ((size_t)(mem_data + addr + read_size) & (sys_page_size - 1));
+                const size_t skip_size = (page_remaining < size - read_size) ? page_remaining : size - read_size;
+                memset(out_data + read_size, 0, skip_size);
+                memset(out_state + read_size, ByteState_Unreadable, skip_size);
+                addr += read_size + skip_size;
+                out_data += read_size + skip_size;
+                out_state += read_size + skip_size;
+                size -= read_size + skip_size;
+            }
+            return;
+        }
+#endif
+        else
+            memcpy(out_data, mem_data + addr, size);
+        memset(out_state, ByteState_Valid, size);
+    }
+
+    // Write [addr, addr+size) in one go (one Source->Write() or process_vm_writev() call). WriteFn is still called for each byte.
+    void WriteRange(ImU8* mem_data, size_t addr, const ImU8* src, size_t size)
+    {
+        MemoryEditorUndoJournal& journal = GetShared().Journal;
+        const size_t data_offset = GetDataOffset(mem_data);
+        if (IsRecordingUndo() && !journal.Replaying)
+        {
+            // History belongs to one data: writing to another Source starts a new history
+            SharedState& shared = GetShared();
+            if (shared.JournalSource != Source)
+                journal.Clear();
+            shared.JournalSource = Source;
+            // Read old bytes honoring region policies (cached bytes aren't read again) and record them with the new ones, one chunk at a time
+            const size_t chunk_size = MemoryEditorUndoJournal::ChunkSize;
+            journal.BeginTransaction();
+            journal.ReadBuf.resize((int)chunk_size * 2);
+            for (size_t off = 0; off < size; off += chunk_size)
+            {
+                const size_t n = (size - off < chunk_size) ? size - off : chunk_size;
+                ReadRange(mem_data, addr + off, journal.ReadBuf.Data, journal.ReadBuf.Data + chunk_size, n);
+                journal.Record(data_offset + addr + off, journal.ReadBuf.Data, journal.ReadBuf.Data + chunk_size, src + off, n);
+            }
+            journal.EndTransaction();
+        }
+
+        if (Source)
+            Source->Write(addr, src, size);
+        else if (WriteFn)
+            for (size_t n = 0; n < size; n++)
+                WriteFn(mem_data, addr + n, src[n]);
+#ifdef IMGUI_MEMORY_EDITOR_POSIX
+        else if (OptSafeReads)
+        {
+            struct iovec local_iov = { (void*)src, size };
+            struct iovec remote_iov = { mem_data + addr, size };
+            process_vm_writev(getpid(), &local_iov, 1, &remote_iov, 1, 0);
+        }
+#endif
+        else
+            memcpy(mem_data + addr, src, size);
+        GetShared().Cache.Update(data_offset + addr, src, size);
+    }
+
+    void WriteByte(ImU8* mem_data, size_t addr, ImU8 value)
+    {
+        WriteRange(mem_data, addr, &value, 1);
+    }
+
+    // Apply 't' to [addr_min, addr_max): read, transform and write back 256 KB at a time (fits L2). Bytes which can't be read are left untouched.
+    // Return number of bytes written.
+    size_t ApplyTransform(ImU8* mem_data, size_t addr_min, size_t addr_max, const Transform& t)
+    {
+        IM_ASSERT(t.KeySize > 0 && t.KeySize <= Transform::KeyMaxSize);
+        BeginTransaction();
+        const size_t chunk_size = 256 * 1024;
+        const size_t buf_size = (addr_max - addr_min < chunk_size) ? addr_max - addr_min : chunk_size;
+        ImU8* buf = (ImU8*)Allocator.Alloc(buf_size * 2);
+        ImU8* buf_state = buf + buf_size;
+        size_t written = 0;
+        for (size_t addr = addr_min; addr < addr_max; addr += buf_size)
+        {
+            const size_t size = (addr_max - addr < buf_size) ? addr_max - addr : buf_size;
+            if (t.Op == TransformOp_Fill)
+                memset(buf_state, ByteState_Valid, size); // no need to read
+            else
+                ReadRangeUncached(mem_data, GetDataOffset(mem_data), addr, buf, buf_state, size);
+            TransformBytes(t, addr - addr_min, buf, size);
+            for (size_t i_min = 0, i_max; i_min < size; i_min = i_max)
+            {
+                for (i_max = i_min + 1; i_max < size && buf_state[i_max] == buf_state[i_min]; i_max++) {}
+                if (buf_state[i_min] == ByteState_Valid)
+                {
+                    WriteRange(mem_data, addr + i_min, buf + i_min, i_max - i_min);
+                    written += i_max - i_min;
+                }
+            }
+        }
+        Allocator.Free(buf, buf_size * 2);
+        EndTransaction();
+        return written;
+    }
+
+    // Insert/erase bytes when Source is resizable (e.g. MemoryEditorFileSource). Cached bytes and undo history are discarded: history only records overwrites.
+    bool InsertRange(size_t addr, const ImU8* src, size_t size)
+    {
+        if (Source == NULL || !Source->IsResizable() || Source->Insert(addr, src, size) != size)
+            return false;
+        OnSourceResized();
+        return true;
+    }
+
+    bool EraseRange(size_t addr, size_t size)
+    {
+        if (Source == NULL || !Source->IsResizable() || Source->Erase(addr, size) == 0)
+            return false;
+        OnSourceResized();
+        return true;
+    }
+
+    bool IsResizable() const { return Source != NULL && Source->IsResizable(); }
+
+    // Displayed address of byte 'addr' (before base_display_addr), and back. They only differ for sources which aren't contiguous.
+    size_t GetDisplayAddr(size_t addr) const { return Source ? Source->GetAddr(addr) : addr; }
+    size_t FindDisplayAddr(size_t display_addr) const { return Source ? Source->FindOffset(display_addr) : display_addr; }
+
+    // Offsets of bytes after an insertion/deletion changed: jobs reading the source would mix data from before and after the edit.
+    void OnSourceResized()
+    {
+        CancelJob(&Search.Job);
+        CancelJob(&Copy.Job);
+        CancelJob(&Export.Job);
+        SharedState& shared = GetShared();
+        shared.Cache.Clear();
+        shared.Journal.Clear();
+    }
+
+    bool    IsRecordingUndo() const     { return OptUndo && (OptUndoSources || (Source == NULL && WriteFn == NULL)); }
+
+    // Group writes into a single undoable transaction (e.g. chunked writes of a large operation).
+    void    BeginTransaction()          { GetShared().Journal.BeginTransaction(); }
+    void    EndTransaction()            { GetShared().Journal.EndTransaction(); }
+
+    // A transaction can only be undone/redone by a view showing all its bytes: not by a view of another part of the data, nor once the data shrank.
+    bool CanUndo(const void* mem_data, size_t mem_size) const
+    {
+        const SharedState& shared = GetShared();
+        return shared.Journal.CanUndo() && shared.JournalSource == Source && shared.Journal.IsTransactionInRange(shared.Journal.Transactions[shared.Journal.UndoCount - 1], GetDataOffset(mem_data), mem_size);
+    }
+
+    bool CanRedo(const void* mem_data, size_t mem_size) const
+    {
+        const SharedState& shared = GetShared();
+        return shared.Journal.CanRedo() && shared.JournalSource == Source && shared.Journal.IsTransactionInRange(shared.Journal.Transactions[shared.Journal.UndoCount], GetDataOffset(mem_data), mem_size);
+    }
+
+    // Undo/redo the last transaction. Return false when it can't be undone/redone (see CanUndo()) or history couldn't be read back.
+    bool Undo(ImU8* mem_data, size_t mem_size)
+    {
+        MemoryEditorUndoJournal& journal = GetShared().Journal;
+        if (!CanUndo(mem_data, mem_size))
+            return false;
+        journal.UndoCount--;
+        return ReplayTransaction(mem_data, journal.Transactions[journal.UndoCount], true);
+    }
+
+    bool Redo(ImU8* mem_data, size_t mem_size)
+    {
+        MemoryEditorUndoJournal& journal = GetShared().Journal;
+        if (!CanRedo(mem_data, mem_size))
+            return false;
+        journal.UndoCount++;
+        return ReplayTransaction(mem_data, journal.Transactions[journal.UndoCount - 1], false);
+    }
+
+    // Write old (undo) or new (redo) bytes of a transaction, deltas in reverse order for undo. Old bytes which weren't valid are skipped.
+    // Consecutive deltas covering contiguous bytes don't overlap: they are decoded together and written with one WriteRange() call of up to 4 MB per run of valid bytes.
+    bool ReplayTransaction(ImU8* mem_data, const MemoryEditorUndoJournal::Transaction& tx, bool undo)
+    {
+        MemoryEditorUndoJournal& journal = GetShared().Journal;
+        const size_t batch_size = (tx.Size < (size_t)4 * 1024 * 1024) ? tx.Size : (size_t)4 * 1024 * 1024; // deltas of a group never add up to more than the transaction
+        ImU8* buf = (ImU8*)Allocator.Alloc(batch_size * 2);
+        ImU8* buf_state = buf + batch_size;
+        const size_t data_offset = GetDataOffset(mem_data);
+        bool ok = true;
+        journal.Replaying = true;
+        for (ImU64 n = 0; n < tx.DeltaEnd - tx.DeltaBegin; )
+        {
+            ImU64 group_min = undo ? tx.DeltaEnd - 1 - n : tx.DeltaBegin + n;
+            ImU64 group_max = group_min + 1;
+            size_t group_size = journal.GetDelta(group_min).Size;
+            if (undo)
+                while (group_min > tx.DeltaBegin && IsDeltaFollowedBy(journal.GetDelta(group_min - 1), journal.GetDelta(group_min)) && group_size + journal.GetDelta(group_min - 1).Size <= batch_size)
+                    group_size += journal.GetDelta(--group_min).Size;
+            else
+                while (group_max < tx.DeltaEnd && IsDeltaFollowedBy(journal.GetDelta(group_max - 1), journal.GetDelta(group_max)) && group_size + journal.GetDelta(group_max).Size <= batch_size)
+                    group_size += journal.GetDelta(group_max++).Size;
+            const size_t group_addr = journal.GetDelta(group_min).Addr;
+            bool group_ok = true;
+            for (ImU64 delta_n = group_min; delta_n < group_max && group_ok; delta_n++)
+            {
+                const MemoryEditorUndoJournal::Delta& delta = journal.GetDelta(delta_n);
+                group_ok = journal.LoadDelta(tx, delta, undo, buf + (delta.Addr - group_addr), buf_state + (delta.Addr - group_addr));
+            }
+            for (size_t run_min = 0, run_max; group_ok && run_min < group_size; run_min = run_max)
+            {
+                for (run_max = run_min + 1; run_max < group_size && (buf_state[run_max] == ByteState_Valid) == (buf_state[run_min] == ByteState_Valid); run_max++) {}
+                if (buf_state[run_min] == ByteState_Valid)
+                    WriteRange(mem_data, group_addr - data_offset + run_min, buf + run_min, run_max - run_min);
+            }
+            ok &= group_ok;
+            n += group_max - group_min;
+        }
+        journal.Replaying = false;
+        Allocator.Free(buf, batch_size * 2);
+        return ok;
+    }
+    static bool IsDeltaFollowedBy(const MemoryEditorUndoJournal::Delta& a, const MemoryEditorUndoJournal::Delta& b) { return a.Addr + a.Size == b.Addr; }
+
+    // Read [addr, addr+size) honoring region policies. 'out_state' receives a ByteState for each byte.
+    // With 'store' false, bytes read from the target are not stored in the cache: call StoreRange() once they are known to be consistent.
+    void ReadRange(const ImU8* mem_data, size_t addr, ImU8* out_data, ImU8* out_state, size_t size, bool store = true)
+    {
+        SharedState& shared = GetShared();
+        const size_t data_offset = GetDataOffset(mem_data);
+        while (size > 0)
+        {
+            const Region* region;
+            const size_t run = FindRegionRun(data_offset + addr, size, &region);
+            if (region == NULL && !IsCachingAll())
+            {
+                ReadDirect(mem_data, addr, out_data, out_state, run);
+            }
+            else
+            {
+                const bool can_read = (region == NULL) || (region->Policy != RegionPolicy_NeverRead) || shared.RefreshReadAll;
+                for (size_t n = 0; n < run; )
+                {
+                    // Process each sequence of cached/uncached bytes in one go
+                    const size_t off = data_offset + addr + n;
+                    MemoryEditorPageCache::Page* page = shared.Cache.GetPage(off >> MemoryEditorPageCache::PageSizeShift, can_read);
+                    size_t i = off & (MemoryEditorPageCache::PageSize - 1);
+                    const bool valid = page && (page->ValidMask[i >> 5] & ((ImU32)1 << (i & 31))) != 0;
+                    size_t count = 1;
+                    while (n + count < run && ++i < MemoryEditorPageCache::PageSize && (page && (page->ValidMask[i >> 5] & ((ImU32)1 << (i & 31))) != 0) == valid)
+                        count++;
+                    if (valid)
+                    {
+                        memcpy(out_data + n, page->Data + (off & (MemoryEditorPageCache::PageSize - 1)), count);
+                        memset(out_state + n, ByteState_Valid, count);
+                    }
+                    else if (can_read)
+                    {
+                        ReadDirect(mem_data, addr + n, out_data + n, out_state + n, count);
+                        if (store)
+                            StoreValidBytes(off, out_data + n, out_state + n, count);
+                    }
+                    else
+                    {
+                        memset(out_data + n, 0, count);
+                        memset(out_state + n, ByteState_NotRead, count);
+                    }
+                    n += count;
+                }
+            }
+            addr += run;
+            out_data += run;
+            out_state += run;
+            size -= run;
+        }
+    }
+
+    // Store bytes returned by ReadRange(..., store = false) in the cache, where ReadRange() would have stored them.
+    void StoreRange(const ImU8* mem_data, size_t addr, const ImU8* data, const ImU8* state, size_t size)
+    {
+        const size_t data_offset = GetDataOffset(mem_data);
+        while (size > 0)
+        {
+            const Region* region;
+            const size_t run = FindRegionRun(data_offset + addr, size, &region);
+            if (region != NULL || IsCachingAll())
+                StoreValidBytes(data_offset + addr, data, state, run);
+            addr += run;
+            data += run;
+            state += run;
+            size -= run;
+        }
+    }
+
+    // Unreadable bytes are not cached, they are retried on next read
+    void StoreValidBytes(size_t off, const ImU8* data, const ImU8* state, size_t size)
+    {
+        for (size_t i_min = 0, i_max; i_min < size; i_min = i_max)
+        {
+            for (i_max = i_min + 1; i_max < size && state[i_max] == state[i_min]; i_max++) {}
+            if (state[i_min] == ByteState_Valid)
+                GetShared().Cache.Store(off + i_min, data + i_min, i_max - i_min);
+        }
+    }
+
+    // Return true when memory outside of regions is served from the cache.
+    bool IsCachingAll() const
+    {
+#ifdef IMGUI_MEMORY_EDITOR_POSIX
+        if (WriteWatch != NULL && Source == NULL)
+            return true;
+#endif
+        return RefreshRate > 0.0f;
+    }
+
+    // Change tracking, from Source or WriteWatch. When BeginChangeQuery() returns false, all cached data is considered stale.
+    bool BeginChangeQuery()
+    {
+        if (Source)
+            return Source->BeginChangeQuery();
+#ifdef IMGUI_MEMORY_EDITOR_POSIX
+        if (WriteWatch && WriteWatch->IsWatching())
+        {
+            WriteWatch->Rearm(); // take dirty flags before pages are re-read
+            return true;
+        }
+#endif
+        return false;
+    }
+
+    bool IsRangeChanged(const void* mem_data, size_t addr, size_t size)
+    {
+        if (Source)
+            return Source->IsRangeChanged(addr, size);
+#ifdef IMGUI_MEMORY_EDITOR_POSIX
+        if (WriteWatch)
+            return WriteWatch->IsRangeDirty((const ImU8*)mem_data + addr, size);
+#endif
+        IM_UNUSED(mem_data);
+        return true;
+    }
+
+    void EndChangeQuery()
+    {
+        if (Source)
+            Source->EndChangeQuery();
+    }
+
+    // Invalidate cached bytes of [addr_min, addr_max) which are outside of any region.
+    void InvalidateGaps(size_t addr_min, size_t addr_max)
+    {
+        SharedState& shared = GetShared();
+        size_t gap_min = addr_min;
+        for (const Region& region : shared.Regions)
+        {
+            if (region.Max <= gap_min)
+                continue;
+            if (region.Min >= addr_max)
+                break;
+            if (region.Min > gap_min)
+                shared.Cache.Invalidate(gap_min, region.Min - gap_min);
+            gap_min = region.Max;
+        }
+        if (gap_min < addr_max)
+            shared.Cache.Invalidate(gap_min, addr_max - gap_min);
+    }
+
+    // Register memory held by the engine with MemoryBudget and release memory when over budget. Call once per frame before UpdateCache():
+    // cache pages not accessed since the previous UpdateCache() are cold.
+    void UpdateMemoryBudget()
+    {
+        SharedState& shared = GetShared();
+        MemoryEditorMemoryBudget::Attach(&shared.CacheConsumer, MemoryBudget, &shared.Cache);
+        MemoryEditorMemoryBudget::Attach(&shared.JournalConsumer, MemoryBudget, &shared.Journal);
+        MemoryEditorMemoryBudget::Attach(&Search.BufferConsumer, MemoryBudget, &Search);
+        if (MemoryBudget == NULL)
+            return;
+        shared.CacheConsumer.Usage = shared.Cache.GetMemoryUsage();
+        shared.JournalConsumer.Usage = shared.Journal.GetMemoryUsage();
+        if (!Search.Job.IsBusy())
+            Search.BufferConsumer.Usage = (size_t)(Search.Buffer.Capacity + Search.BufferState.Capacity);
+        MemoryBudget->Update();
+    }
+
+    // Called once per frame before reading: apply refresh requests and refresh rates. 'time' is in seconds, 'frame' identifies the current frame.
+    // With a SharedState used by several views, each update is applied once per frame. Memory outside of regions is refreshed at the highest RefreshRate of the views.
+    void UpdateCache(const void* mem_data, size_t mem_size, double time, int frame)
+    {
+        SharedState& shared = GetShared();
+        MemoryEditorPageCache& cache = shared.Cache;
+        cache.SetAllocator(Allocator);
+        const ImU8* data_base = Source ? NULL : shared.DataBase ? shared.DataBase : (shared.LastUpdateFrame == frame) ? shared.CacheDataBase : (const ImU8*)mem_data;
+        if (shared.CacheSource != Source || shared.CacheDataBase != data_base)
+        {
+            // Offsets are from the data base: pages are keyed by it, undo history is moved so its offsets still designate the same bytes.
+            // Offsets in a Source can't be compared with another Source's: history is kept, and only available again once its Source is viewed (see CanUndo()).
+            IM_ASSERT((shared.CacheSource == Source || shared.LastUpdateFrame != frame) && "All views sharing a SharedState must use the same Source (or none).");
+            if (Source == NULL && shared.CacheSource == NULL && shared.CacheDataBase != NULL)
+                shared.Journal.Rebase((size_t)((uintptr_t)shared.CacheDataBase - (uintptr_t)data_base));
+            cache.Clear();
+            shared.CacheSource = Source;
+            shared.CacheDataBase = data_base;
+        }
+        const size_t data_offset = GetDataOffset(mem_data);
+
+        if (IsCachingAll() && shared.LastRefreshFrame != frame && (RefreshRate <= 0.0f || time - shared.LastRefreshTime >= 1.0 / RefreshRate))
+        {
+            // Invalidate memory in-between regions. When changes are tracked, only invalidate pages which changed.
+            // Pages which end up empty are released so the cache doesn't grow with scrolling.
+            if (BeginChangeQuery())
+            {
+                for (int n = 0; n < cache.Pages.Size; n++)
+                {
+                    // Pages may hold bytes of other views: query them relative to mem_data too (don't query past the end of this view's data)
+                    const size_t page_off = cache.Pages[n]->Index << MemoryEditorPageCache::PageSizeShift;
+                    const size_t page_addr = page_off - data_offset;
+                    const size_t page_size = (page_addr < mem_size && mem_size - page_addr < (size_t)MemoryEditorPageCache::PageSize) ? mem_size - page_addr : (size_t)MemoryEditorPageCache::PageSize;
+                    if (IsRangeChanged(mem_data, page_addr, page_size))
+                        InvalidateGaps(page_off, (page_off + page_size != 0) ? page_off + page_size : (size_t)-1); // last page below a wrap
+                }
+                EndChangeQuery();
+            }
+            else
+            {
+                InvalidateGaps(0, (size_t)-1);
+            }
+            cache.RemoveEmptyPages();
+            shared.LastRefreshTime = time;
+            shared.LastRefreshFrame = frame;
+        }
+        if (shared.LastUpdateFrame == frame)
+            return;
+        shared.LastUpdateFrame = frame;
+        cache.UseClock++;
+        shared.RefreshReadAll = shared.RefreshRequested;
+        shared.RefreshRequested = false;
+        if (shared.RefreshReadAll)
+            cache.Clear();
+        for (Region& region : shared.Regions)
+        {
+            if (region.Policy != RegionPolicy_Volatile)
+                continue;
+            const float refresh_rate = (region.RefreshRate < 0.0f) ? RefreshRate : region.RefreshRate;
+            if (refresh_rate <= 0.0f || time - region.LastRefreshTime >= 1.0 / refresh_rate)
+            {
+                cache.Invalidate(region.Min, region.Max - region.Min);
+                region.LastRefreshTime = time;
+            }
+        }
+    }
+
+    // Utilities for Data Preview
+    // The static functions below have no hidden state: they may be called concurrently, e.g. from jobs formatting values off the UI thread.
+    static const char* DataTypeGetDesc(ImGuiDataType data_type)
+    {
+        const char* descs[] = { "Int8", "Uint8", "Int16", "Uint16", "Int32", "Uint32", "Int64", "Uint64", "Float", "Double" };
+        IM_ASSERT(data_type >= 0 && data_type < ImGuiDataType_COUNT);
+        return descs[data_type];
+    }
+
+    static size_t DataTypeGetSize(ImGuiDataType data_type)
+    {
+        const size_t sizes[] = { 1, 1, 2, 2, 4, 4, 8, 8, sizeof(float), sizeof(double) };
+        IM_ASSERT(data_type >= 0 && data_type < ImGuiDataType_COUNT);
+        return sizes[data_type];
+    }
+
+    static const char* DataFormatGetDesc(DataFormat data_format)
+    {
+        const char* descs[] = { "Bin", "Dec", "Hex" };
+        IM_ASSERT(data_format >= 0 && data_format < DataFormat_COUNT);
+        return descs[data_format];
+    }
+
+    static bool IsBigEndian()
+    {
+        uint16_t x = 1;
+        char c[2];
+        memcpy(c, &x, 2);
+        return c[0] != 0;
+    }
+
+    static void* EndiannessCopyBigEndian(void* _dst, void* _src, size_t s, int is_little_endian)
+    {
+        if (is_little_endian)
+        {
+            uint8_t* dst = (uint8_t*)_dst;
+            uint8_t* src = (uint8_t*)_src + s - 1;
+            for (int i = 0, n = (int)s; i < n; ++i)
+                memcpy(dst++, src--, 1);
+            return _dst;
+        }
+        else
+        {
+            return memcpy(_dst, _src, s);
+        }
+    }
+
+    static void* EndiannessCopyLittleEndian(void* _dst, void* _src, size_t s, int is_little_endian)
+    {
+        if (is_little_endian)
+        {
+            return memcpy(_dst, _src, s);
+        }
+        else
+        {
+            uint8_t* dst = (uint8_t*)_dst;
+            uint8_t* src = (uint8_t*)_src + s - 1;
+            for (int i = 0, n = (int)s; i < n; ++i)
+                memcpy(dst++, src--, 1);
+            return _dst;
+        }
+    }
+
+    // Copy 'size' bytes from 'src' stored with 'endianness' byte order (same values as PreviewEndianness) to 'dst' in host byte order.
+    static void* EndiannessCopy(void* dst, void* src, size_t size, int endianness)
+    {
+        return IsBigEndian() ? EndiannessCopyBigEndian(dst, src, size, endianness) : EndiannessCopyLittleEndian(dst, src, size, endianness);
+    }
+
+    // Write 'width' bits of 'buf' as groups of 8 binary digits into 'out_buf' (at least width + width / 8 + 1 chars). Returns 'out_buf'.
+    static const char* FormatBinary(const uint8_t* buf, int width, char* out_buf, size_t out_buf_size)
+    {
+        IM_ASSERT(width <= 64 && out_buf_size > 0);
+        size_t out_n = 0;
+        int n = width / 8;
+        for (int j = n - 1; j >= 0 && out_n + 9 < out_buf_size; --j)
+        {
+            for (int i = 0; i < 8; ++i)
+                out_buf[out_n++] = (buf[j] & (1 << (7 - i))) ? '1' : '0';
+            out_buf[out_n++] = ' ';
+        }
+        out_buf[out_n] = 0;
+        return out_buf;
+    }
+
+    // Format 'size' bytes of 'buf' (stored with 'endianness' byte order, same values as PreviewEndianness) as 'data_type' into 'out_buf'.
+    static void FormatData(const uint8_t* buf, size_t size, ImGuiDataType data_type, DataFormat data_format, int endianness, char* out_buf, size_t out_buf_size)
+    {
+        uint8_t tmp[8];
+        IM_ASSERT(size <= sizeof(tmp));
+        memcpy(tmp, buf, size);
+        if (data_format == DataFormat_Bin)
+        {
+            uint8_t binbuf[8];
+            EndiannessCopy(binbuf, tmp, size, endianness);
+            FormatBinary(binbuf, (int)size * 8, out_buf, out_buf_size);
+            return;
+        }
+
+        out_buf[0] = 0;
+        switch (data_type)
+        {
+        case ImGuiDataType_S8:
+        {
+            int8_t data = 0;
+            EndiannessCopy(&data, tmp, size, endianness);
+            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%hhd", data); return; }
+            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%02x", data & 0xFF); return; }
+            break;
+        }
+        case ImGuiDataType_U8:
+        {
+            uint8_t data = 0;
+            EndiannessCopy(&data, tmp, size, endianness);
+            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%hhu", data); return; }
+            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%02x", data & 0XFF); return; }
+            break;
+        }
+        case ImGuiDataType_S16:
+        {
+            int16_t data = 0;
+            EndiannessCopy(&data, tmp, size, endianness);
+            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%hd", data); return; }
+            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%04x", data & 0xFFFF); return; }
+            break;
+        }
+        case ImGuiDataType_U16:
+        {
+            uint16_t data = 0;
+            EndiannessCopy(&data, tmp, size, endianness);
+            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%hu", data); return; }
+            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%04x", data & 0xFFFF); return; }
+            break;
+        }
+        case ImGuiDataType_S32:
+        {
+            int32_t data = 0;
+            EndiannessCopy(&data, tmp, size, endianness);
+            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%d", data); return; }
+            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%08x", data); return; }
+            break;
+        }
+        case ImGuiDataType_U32:
+        {
+            uint32_t data = 0;
+            EndiannessCopy(&data, tmp, size, endianness);
+            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%u", data); return; }
+            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%08x", data); return; }
+            break;
+        }
+        case ImGuiDataType_S64:
+        {
+            int64_t data = 0;
+            EndiannessCopy(&data, tmp, size, endianness);
+            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%lld", (long long)data); return; }
+            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%016llx", (long long)data); return; }
+            break;
+        }
+        case ImGuiDataType_U64:
+        {
+            uint64_t data = 0;
+            EndiannessCopy(&data, tmp, size, endianness);
+            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%llu", (long long)data); return; }
+            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%016llx", (long long)data); return; }
+            break;
+        }
+        case ImGuiDataType_Float:
+        {
+            float data = 0.0f;
+            EndiannessCopy(&data, tmp, size, endianness);
+            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%f", data); return; }
+            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "%a", data); return; }
+            break;
+        }
+        case ImGuiDataType_Double:
+        {
+            double data = 0.0;
+            EndiannessCopy(&data, tmp, size, endianness);
+            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%f", data); return; }
+            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "%a", data); return; }
+            break;
+        }
+        case ImGuiDataType_COUNT:
+            break;
+        } // Switch
+        IM_ASSERT(0); // Shouldn't reach
+    }
+
+    enum RowFormatFlags_
+    {
+        RowFormatFlags_UpperCaseHex     = 1 << 0,
+        RowFormatFlags_HexII            = 1 << 1,
+        RowFormatFlags_GreyOutZeroes    = 1 << 2,
+    };
+
+    // Format a row of 'count' bytes (count <= cols) for display. 'out_text' receives 2 hex glyphs per column followed by 1 ASCII glyph per column,
+    // 'out_disabled' receives 1 flag per hex cell followed by 1 flag per ASCII glyph, set for glyphs drawn with the disabled color.
+    static void FormatRow(const ImU8* data, const ImU8* state, int count, int cols, int flags, char* out_text, ImU8* out_disabled)
+    {
+        const char* digits = (flags & RowFormatFlags_UpperCaseHex) ? "0123456789ABCDEF" : "0123456789abcdef";
+        const bool grey_out_zeroes = (flags & RowFormatFlags_GreyOutZeroes) != 0;
+        char* out_ascii = out_text + cols * 2;
+        ImU8* out_ascii_disabled = out_disabled + cols;
+        for (int n = 0; n < count; n++)
+        {
+            const ImU8 b = data[n];
+            char* out = out_text + n * 2;
+            ImU8 disabled = 0;
+            if (state[n] != ByteState_Valid)
+            {
+                out[0] = out[1] = (state[n] == ByteState_Unreadable) ? '?' : '-';
+                disabled = 1;
+            }
+            else if ((flags & RowFormatFlags_HexII) && b >= 32 && b < 128)
+            {
+                out[0] = '.';
+                out[1] = (char)b;
+            }
+            else if ((flags & RowFormatFlags_HexII) && b == 0xFF && grey_out_zeroes)
+            {
+                out[0] = out[1] = '#';
+                disabled = 1;
+            }
+            else if ((flags & RowFormatFlags_HexII) && b == 0x00)
+            {
+                out[0] = out[1] = ' ';
+            }
+            else
+            {
+                out[0] = digits[b >> 4];
+                out[1] = digits[b & 0x0F];
+                disabled = (b == 0 && grey_out_zeroes && !(flags & RowFormatFlags_HexII));
+            }
+            out_disabled[n] = disabled;
+            const char c = (state[n] == ByteState_Unreadable) ? '?' : (state[n] != ByteState_Valid) ? '-' : (b < 32 || b >= 128) ? '.' : (char)b;
+            out_ascii[n] = c;
+            out_ascii_disabled[n] = (state[n] != ByteState_Valid || c != (char)b);
+        }
+        for (int n = count; n < cols; n++)
+        {
+            out_text[n * 2] = out_text[n * 2 + 1] = out_ascii[n] = ' ';
+            out_disabled[n] = out_ascii_disabled[n] = 0;
+        }
+    }
+
+    // Write 2 hex digits per byte of 'src' into 'out' (not zero-terminated). With SSE2, 16 bytes are encoded per iteration.
+    static void EncodeHex(const ImU8* src, size_t size, char* out, bool upper_case)
+    {
+#ifdef IMGUI_MEMORY_EDITOR_SSE2
+        const __m128i mask_nibble = _mm_set1_epi8(0x0F);
+        const __m128i nine = _mm_set1_epi8(9);
+        const __m128i char_0 = _mm_set1_epi8('0');
+        const __m128i letter_offset = _mm_set1_epi8(upper_case ? 'A' - '0' - 10 : 'a' - '0' - 10);
+        for (; size >= 16; size -= 16, src += 16, out += 32)
+        {
+            const __m128i bytes = _mm_loadu_si128((const __m128i*)(const void*)src);
+            const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask_nibble);
+            const __m128i lo = _mm_and_si128(bytes, mask_nibble);
+            __m128i digits_0 = _mm_unpacklo_epi8(hi, lo);
+            __m128i digits_1 = _mm_unpackhi_epi8(hi, lo);
+            digits_0 = _mm_add_epi8(_mm_add_epi8(digits_0, char_0), _mm_and_si128(_mm_cmpgt_epi8(digits_0, nine), letter_offset));
+            digits_1 = _mm_add_epi8(_mm_add_epi8(digits_1, char_0), _mm_and_si128(_mm_cmpgt_epi8(digits_1, nine), letter_offset));
+            _mm_storeu_si128((__m128i*)(void*)out, digits_0);
+            _mm_storeu_si128((__m128i*)(void*)(out + 16), digits_1);
+        }
+#endif
+        const char* digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+        for (size_t n = 0; n < size; n++)
+        {
+            out[n * 2] = digits[src[n] >> 4];
+            out[n * 2 + 1] = digits[src[n] & 0x0F];
+        }
+    }
+
+    static const char* TransformOpGetDesc(TransformOp op)
+    {
+        const char* descs[] = { "Fill", "Xor", "And", "Or", "Add", "Rotate left" };
+        IM_ASSERT(op >= 0 && op < TransformOp_COUNT);
+        return descs[op];
+    }
+
+    // Apply 't' to 'data', where data[0] is at offset 'offset' of the transformed range (selects the first key byte).
+    // With SSE2, 16 bytes are processed per iteration, rotations only when the key is a single byte.
+    static void TransformBytes(const Transform& t, size_t offset, ImU8* data, size_t size)
+    {
+        const size_t key_size = (size_t)t.KeySize;
+        size_t key_n = offset % key_size;
+        size_t n = 0;
+#ifdef IMGUI_MEMORY_EDITOR_SSE2
+        if (t.Op != TransformOp_RotateLeft || key_size == 1)
+        {
+            // Key repeated over 16 + key_size bytes: the key of any block of 16 bytes is a contiguous slice of it
+            ImU8 key_line[16 + Transform::KeyMaxSize];
+            for (size_t i = 0; i < 16 + key_size; i++)
+                key_line[i] = t.Key[i % key_size];
+            const int rotation = t.Key[0] & 7;
+            const __m128i mask_lo = _mm_set1_epi8((char)(0xFF >> (8 - rotation) & 0xFF));
+            for (; size - n >= 16; n += 16)
+            {
+                const __m128i key = _mm_loadu_si128((const __m128i*)(const void*)(key_line + key_n));
+                __m128i* p = (__m128i*)(void*)(data + n);
+                __m128i v = (t.Op == TransformOp_Fill) ? key : _mm_loadu_si128(p);
+                switch (t.Op)
+                {
+                case TransformOp_Xor:   v = _mm_xor_si128(v, key); break;
+                case TransformOp_And:   v = _mm_and_si128(v, key); break;
+                case TransformOp_Or:    v = _mm_or_si128(v, key); break;
+                case TransformOp_Add:   v = _mm_add_epi8(v, key); break;
+                case TransformOp_RotateLeft:
+                    if (rotation != 0)
+                        v = _mm_or_si128(_mm_andnot_si128(mask_lo, _mm_slli_epi16(v, rotation)), _mm_and_si128(mask_lo, _mm_srli_epi16(v, 8 - rotation)));
+                    break;
+                default: break;
+                }
+                _mm_storeu_si128(p, v);
+                key_n = (key_n + 16) % key_size;
+            }
+        }
+#endif
+        for (; n < size; n++)
+        {
+            const ImU8 key = t.Key[key_n];
+            ImU8& b = data[n];
+            switch (t.Op)
+            {
+            case TransformOp_Fill:          b = key; break;
+            case TransformOp_Xor:           b ^= key; break;
+            case TransformOp_And:           b &= key; break;
+            case TransformOp_Or:            b |= key; break;
+            case TransformOp_Add:           b = (ImU8)(b + key); break;
+            case TransformOp_RotateLeft:    b = (ImU8)((b << (key & 7)) | (b >> ((8 - (key & 7)) & 7))); break;
+            default: break;
+            }
+            if (++key_n == key_size)
+                key_n = 0;
+        }
+    }
+
+    static int HexDigitValue(char c)
+    {
+        return (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+    }
+
+    // Decode hex text into 'out', which must hold text_len / 2 bytes. Digits are paired across separators: whitespace, ',', ';', ':', '-',
+    // and "0x"/"\\x" prefixes are skipped. Return number of bytes decoded, or (size_t)-1 when the text holds another character or an odd
+    // number of digits, with its offset in *out_error_offset. With SSE2, blocks of 16 characters are classified and validated at once.
+    static size_t DecodeHex(const char* text, size_t text_len, ImU8* out, size_t* out_error_offset)
+    {
+        size_t count = 0;
+        int pending = -1;                       // high nibble waiting for its low nibble
+#ifdef IMGUI_MEMORY_EDITOR_SSE2
+        size_t scalar_end = 0;                  // characters before this offset are decoded one by one
+#endif
+        for (size_t n = 0; n < text_len; )
+        {
+#ifdef IMGUI_MEMORY_EDITOR_SSE2
+            if (n >= scalar_end && text_len - n >= 16)
+            {
+                const __m128i chars = _mm_loadu_si128((const __m128i*)(const void*)(text + n));
+                const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+                const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+                const __m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+                const __m128i values = _mm_or_si128(_mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))), _mm_and_si128(is_letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+                const int hex_mask = _mm_movemask_epi8(_mm_or_si128(is_digit, is_letter));
+                if (hex_mask == 0xFFFF && pending < 0)
+                {
+                    // 16 digits: pair even and odd characters
+                    const __m128i hi = _mm_and_si128(values, _mm_set1_epi16(0x00FF));
+                    const __m128i lo = _mm_srli_epi16(values, 8);
+                    const __m128i bytes = _mm_or_si128(_mm_slli_epi16(hi, 4), lo);
+                    _mm_storel_epi64((__m128i*)(void*)(out + count), _mm_packus_epi16(bytes, bytes));
+                    count += 8;
+                    n += 16;
+                    continue;
+                }
+                __m128i is_sep = _mm_cmpeq_epi8(chars, _mm_set1_epi8(' '));
+                is_sep = _mm_or_si128(is_sep, _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t')));
+                is_sep = _mm_or_si128(is_sep, _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')));
+                is_sep = _mm_or_si128(is_sep, _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')));
+                is_sep = _mm_or_si128(is_sep, _mm_cmpeq_epi8(chars, _mm_set1_epi8(',')));
+                is_sep = _mm_or_si128(is_sep, _mm_cmpeq_epi8(chars, _mm_set1_epi8(';')));
+                is_sep = _mm_or_si128(is_sep, _mm_cmpeq_epi8(chars, _mm_set1_epi8(':')));
+                is_sep = _mm_or_si128(is_sep, _mm_cmpeq_epi8(chars, _mm_set1_epi8('-')));
+                const int sep_mask = _mm_movemask_epi8(is_sep);
+                const int x_mask = _mm_movemask_epi8(_mm_cmpeq_epi8(lower, _mm_set1_epi8('x')));
+                const int zero_mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('0')));
+                const int prefix_mask = x_mask >> 1;    // '0' of "0x" prefixes
+                const bool split_prefix = (zero_mask & 0x8000) && n + 16 < text_len && (text[n + 16] == 'x' || text[n + 16] == 'X');
+                if ((hex_mask | sep_mask | x_mask) == 0xFFFF && (x_mask & 1) == 0 && (prefix_mask & ~zero_mask) == 0 && !split_prefix)
+                {
+                    ImU8 digits[16];
+                    _mm_storeu_si128((__m128i*)(void*)digits, values);
+                    for (int i = 0; i < 16; i++)
+                    {
+                        if ((hex_mask & (1 << i)) == 0)
+                            continue;
+                        if (prefix_mask & (1 << i))
+                        {
+                            if (pending < 0)
+                            {
+                                i++;            // skip "0x"
+                                continue;
+                            }
+                            // '0' completes a byte, then 'x' is invalid
+                            if (out_error_offset)
+                                *out_error_offset = n + i + 1;
+                            return (size_t)-1;
+                        }
+                        if (pending < 0)
+                            pending = digits[i];
+                        else
+                        {
+                            out[count++] = (ImU8)((pending << 4) | digits[i]);
+                            pending = -1;
+                        }
+                    }
+                    n += 16;
+                    continue;
+                }
+                scalar_end = n + 16;
+            }
+#endif
+            const char c = text[n];
+            const int value = HexDigitValue(c);
+            if ((c == '0' || c == '\\') && pending < 0 && n + 1 < text_len && (text[n + 1] == 'x' || text[n + 1] == 'X'))
+            {
+                n += 2;
+            }
+            else if (value >= 0)
+            {
+                if (pending < 0)
+                    pending = value;
+                else
+                {
+                    out[count++] = (ImU8)((pending << 4) | value);
+                    pending = -1;
+                }
+                n++;
+            }
+            else if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ';' || c == ':' || c == '-')
+            {
+                n++;
+            }
+            else
+            {
+                if (out_error_offset)
+                    *out_error_offset = n;
+                return (size_t)-1;
+            }
+        }
+        if (pending >= 0)
+        {
+            if (out_error_offset)
+                *out_error_offset = text_len;
+            return (size_t)-1;
+        }
+        return count;
+    }
+
+    static const char* TextFormatGetDesc(TextFormat format)
+    {
+        const char* descs[] = { "Hex", "Hex dump", "C array", "Base64", "Python bytes", "xxd", "Rust array", "Intel HEX", "S-record", "Raw binary" };
+        IM_ASSERT(format >= 0 && format < TextFormat_COUNT);
+        return descs[format];
+    }
+
+    // Number of bytes per line/group: encoding may be split in chunks which are multiples of this size.
+    static size_t TextFormatGetUnitSize(TextFormat format, int cols)
+    {
+        switch (format)
+        {
+        case TextFormat_HexDump:    return (size_t)cols;
+        case TextFormat_CArray:     return 16;
+        case TextFormat_Base64:     return 3;
+        case TextFormat_Xxd:        return 16;
+        case TextFormat_RustArray:  return 16;
+        case TextFormat_IntelHex:   return 16;
+        case TextFormat_SRecord:    return 16;
+        default:                    return 1;
+        }
+    }
+
+    // Exact number of characters needed to encode 'size' bytes displayed at 'addr', excluding zero-terminator.
+    static size_t TextFormatCalcSize(TextFormat format, size_t size, size_t addr, int cols, int addr_digits)
+    {
+        return TextFormatCalcSize(format, size, 0, size, addr, cols, addr_digits);
+    }
+
+    // Exact number of characters written by TextFormatEncode() for a chunk of 'size' bytes at 'offset' in a range of 'total_size' bytes.
+    // 'addr' is the displayed address of the first byte of the chunk.
+    static size_t TextFormatCalcSize(TextFormat format, size_t size, size_t offset, size_t total_size, size_t addr, int cols, int addr_digits)
+    {
+        const bool first = (offset == 0), last = (offset + size == total_size);
+        switch (format)
+        {
+        case TextFormat_Xxd:            return ((size + 15) / 16) * ((size_t)XxdGetAddrDigits(addr_digits) + 44) + size;    // "addr: " + 8 groups "xxxx " + " " + ascii + "\n"
+        case TextFormat_RustArray:      return (first ? (size_t)snprintf(NULL, 0, "pub const DATA: [u8; %" _PRISizeT "u] = [\n", total_size) : 0) + ((size + 15) / 16) * 4 + size * 6 + (last ? 3 : 0);
+        case TextFormat_IntelHex:
+        {
+            // Records are split at 16 bytes offsets and at 64 KB boundaries, each 64 KB segment after the first one starts with an extended linear address record
+            if (size == 0)
+                return last ? 12 : 0;
+            const size_t addr32 = addr & 0xFFFFFFFF;
+            const size_t segment_boundaries = ((addr32 + size - 1) >> 16) - (addr32 >> 16);
+            const size_t records = (offset + size + 15) / 16 - offset / 16 + (((addr - offset) & 15) ? segment_boundaries : 0);
+            const size_t extended_records = segment_boundaries + (first ? ((addr32 >> 16) != 0 ? 1 : 0) : ((addr32 & 0xFFFF) == 0 ? 1 : 0));
+            return records * 12 + size * 2 + extended_records * 16 + (last ? 12 : 0);
+        }
+        case TextFormat_SRecord:
+        {
+            const size_t addr_bytes = SRecordGetAddrBytes(addr - offset + total_size);
+            return ((size + 15) / 16) * (7 + addr_bytes * 2) + size * 2 + (last ? 7 + addr_bytes * 2 : 0);
+        }
+        case TextFormat_Raw:            return size;
+        case TextFormat_Hex:            return size * 2;
+        case TextFormat_HexDump:        return ((size + cols - 1) / cols) * ((size_t)addr_digits + 2 + (size_t)cols * 3 + 2) + size;   // "addr: " + "xx " per column + " " + ascii + "\n"
+        case TextFormat_CArray:         return (first ? (size_t)snprintf(NULL, 0, "unsigned char data[%" _PRISizeT "u] = {\n", total_size) : 0) + ((size + 15) / 16) * 4 + size * 6 + (last ? 3 : 0);
+        case TextFormat_Base64:         return ((size + 2) / 3) * 4;
+        case TextFormat_PythonBytes:    return (first ? 2 : 0) + size * 4 + (last ? 1 : 0);
+        default:                        IM_ASSERT(0); return 0;
+        }
+    }
+
+    static bool IsRangeValid(const ImU8* state, size_t size)
+    {
+        ImU8 any_invalid = 0;
+        for (size_t n = 0; n < size; n++)
+            any_invalid |= state[n];
+        return any_invalid == ByteState_Valid;
+    }
+
+    static int      XxdGetAddrDigits(int addr_digits)   { return (addr_digits < 8) ? 8 : addr_digits; }
+    static size_t   SRecordGetAddrBytes(size_t addr_max){ return (addr_max <= 0x10000) ? 2 : (addr_max <= 0x1000000) ? 3 : 4; }
+
+    // Write a record of Intel HEX/S-record: 'prefix', 'header' and 'data' bytes in hex, checksum and new line.
+    // Intel HEX: checksum is the two's complement of the sum of bytes. S-record: one's complement.
+    static char* WriteHexRecord(char* out, const char* prefix, const ImU8* header, size_t header_size, const ImU8* data, const ImU8* state, size_t size, const char* digits)
+    {
+        const bool intel_hex = (prefix[0] == ':');
+        while (*prefix)
+            *out++ = *prefix++;
+        ImU32 sum = 0;
+        for (size_t n = 0; n < header_size; n++, out += 2)
+        {
+            sum += header[n];
+            out[0] = digits[header[n] >> 4];
+            out[1] = digits[header[n] & 0x0F];
+        }
+        if (IsRangeValid(state, size))
+        {
+            EncodeHex(data, size, out, digits[10] == 'A');
+            for (size_t n = 0; n < size; n++)
+                sum += data[n];
+            out += size * 2;
+        }
+        else
+        {
+            for (size_t n = 0; n < size; n++, out += 2)
+            {
+                const ImU8 b = (state[n] == ByteState_Valid) ? data[n] : 0;
+                sum += b;
+                out[0] = digits[b >> 4];
+                out[1] = digits[b & 0x0F];
+            }
+        }
+        const ImU8 checksum = intel_hex ? (ImU8)(0x100 - (sum & 0xFF)) : (ImU8)~sum;
+        out[0] = digits[checksum >> 4];
+        out[1] = digits[checksum & 0x0F];
+        out[2] = '\n';
+        return out + 3;
+    }
+
+    // Encode 'size' bytes at offset 'offset' of a range of 'total_size' bytes, into 'out'. Return number of characters written.
+    // 'offset' must be a multiple of TextFormatGetUnitSize(); headers/footers are written with the first/last chunk. 'addr' is the displayed address of data[0].
+    // Bytes which aren't ByteState_Valid are written as "??"/"--" in hex formats, as zeroes in others.
+    static size_t TextFormatEncode(TextFormat format, const ImU8* data, const ImU8* state, size_t size, size_t offset, size_t total_size, size_t addr, int cols, int addr_digits, int flags, char* out)
+    {
+        const bool upper_case = (flags & RowFormatFlags_UpperCaseHex) != 0;
+        const char* digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+        char* out_begin = out;
+        switch (format)
+        {
+        case TextFormat_Hex:
+            EncodeHex(data, size, out, upper_case);
+            if (!IsRangeValid(state, size))
+                for (size_t n = 0; n < size; n++)
+                    if (state[n] != ByteState_Valid)
+                        out[n * 2] = out[n * 2 + 1] = (state[n] == ByteState_Unreadable) ? '?' : '-';
+            out += size * 2;
+            break;
+        case TextFormat_HexDump:
+            for (size_t line_off = 0; line_off < size; line_off += cols, addr += cols)
+            {
+                const int count = (size - line_off < (size_t)cols) ? (int)(size - line_off) : cols;
+                for (int n = addr_digits - 1; n >= 0; n--)
+                    *out++ = (n * 4 < (int)sizeof(size_t) * 8) ? digits[(addr >> (n * 4)) & 0x0F] : '0';
+                *out++ = ':';
+                *out++ = ' ';
+                char hex[2 * 256];
+                for (int n = 0; n < count; n += 256)
+                {
+                    const int run = (count - n < 256) ? count - n : 256;
+                    EncodeHex(data + line_off + n, (size_t)run, hex, upper_case);
+                    for (int i = 0; i < run; i++, out += 3)
+                    {
+                        const ImU8 byte_state = state[line_off + n + i];
+                        out[0] = (byte_state == ByteState_Valid) ? hex[i * 2] : (byte_state == ByteState_Unreadable) ? '?' : '-';
+                        out[1] = (byte_state == ByteState_Valid) ? hex[i * 2 + 1] : out[0];
+                        out[2] = ' ';
+                    }
+                }
+                memset(out, ' ', (size_t)(cols - count) * 3 + 1);
+                out += (cols - count) * 3 + 1;
+                for (int n = 0; n < count; n++)
+                {
+                    const ImU8 b = data[line_off + n];
+                    const ImU8 byte_state = state[line_off + n];
+                    *out++ = (byte_state == ByteState_Unreadable) ? '?' : (byte_state != ByteState_Valid) ? '-' : (b < 32 || b >= 128) ? '.' : (char)b;
+                }
+                *out++ = '\n';
+            }
+            break;
+        case TextFormat_CArray:
+        case TextFormat_RustArray:
+            if (offset == 0)
+                out += sprintf(out, (format == TextFormat_CArray) ? "unsigned char data[%" _PRISizeT "u] = {\n" : "pub const DATA: [u8; %" _PRISizeT "u] = [\n", total_size);
+            for (size_t line_off = 0; line_off < size; line_off += 16)
+            {
+                const size_t count = (size - line_off < 16) ? size - line_off : 16;
+                memcpy(out, "    ", 4);
+                out += 4;
+                for (size_t n = 0; n < count; n++, out += 6)
+                {
+                    const ImU8 b = (state[line_off + n] == ByteState_Valid) ? data[line_off + n] : 0;
+                    out[0] = '0';
+                    out[1] = 'x';
+                    out[2] = digits[b >> 4];
+                    out[3] = digits[b & 0x0F];
+                    out[4] = ',';
+                    out[5] = (n + 1 < count) ? ' ' : '\n';
+                }
+            }
+            if (offset + size == total_size)
+            {
+                memcpy(out, (format == TextFormat_CArray) ? "};\n" : "];\n", 3);
+                out += 3;
+            }
+            break;
+        case TextFormat_Xxd:
+        {
+            const int xxd_addr_digits = XxdGetAddrDigits(addr_digits);
+            for (size_t line_off = 0; line_off < size; line_off += 16, addr += 16)
+            {
+                const size_t count = (size - line_off < 16) ? size - line_off : 16;
+                for (int n = xxd_addr_digits - 1; n >= 0; n--)
+                    *out++ = (n * 4 < (int)sizeof(size_t) * 8) ? digits[(addr >> (n * 4)) & 0x0F] : '0';
+                *out++ = ':';
+                *out++ = ' ';
+                char hex[32];
+                EncodeHex(data + line_off, count, hex, upper_case);
+                memset(out, ' ', 41);
+                const bool all_valid = IsRangeValid(state + line_off, count);
+                if (all_valid && count == 16)
+                {
+                    for (int n = 0; n < 8; n++)
+                        memcpy(out + n * 5, hex + n * 4, 4);
+                }
+                else
+                {
+                    for (size_t n = 0; n < count; n++)
+                    {
+                        const ImU8 byte_state = state[line_off + n];
+                        out[n * 2 + n / 2] = (byte_state == ByteState_Valid) ? hex[n * 2] : (byte_state == ByteState_Unreadable) ? '?' : '-';
+                        out[n * 2 + n / 2 + 1] = (byte_state == ByteState_Valid) ? hex[n * 2 + 1] : out[n * 2 + n / 2];
+                    }
+                }
+                out += 41;
+                for (size_t n = 0; n < count; n++)
+                {
+                    const ImU8 b = data[line_off + n];
+                    out[n] = ((ImU8)(b - 32) < 95) ? (char)b : '.';
+                }
+                if (!all_valid)
+                    for (size_t n = 0; n < count; n++)
+                        if (state[line_off + n] != ByteState_Valid)
+                            out[n] = '.';
+                out += count;
+                *out++ = '\n';
+            }
+            break;
+        }
+        case TextFormat_IntelHex:
+            for (size_t line_off = 0; line_off < size; )
+            {
+                // 16 bytes records, split at 64 KB boundaries
+                const ImU32 rec_addr = (ImU32)((addr + line_off) & 0xFFFFFFFF);
+                size_t count = 16 - ((offset + line_off) & 15);
+                if (count > size - line_off)
+                    count = size - line_off;
+                if (count > 0x10000 - (rec_addr & 0xFFFF))
+                    count = 0x10000 - (rec_addr & 0xFFFF);
+                if (((offset + line_off == 0) && (rec_addr >> 16) != 0) || (offset + line_off != 0 && (rec_addr & 0xFFFF) == 0))
+                {
+                    const ImU8 ela[6] = { 2, 0, 0, 4, (ImU8)(rec_addr >> 24), (ImU8)(rec_addr >> 16) };
+                    out = WriteHexRecord(out, ":", ela, 6, NULL, NULL, 0, digits);
+                }
+                const ImU8 header[4] = { (ImU8)count, (ImU8)(rec_addr >> 8), (ImU8)rec_addr, 0 };
+                out = WriteHexRecord(out, ":", header, 4, data + line_off, state + line_off, count, digits);
+                line_off += count;
+            }
+            if (offset + size == total_size)
+            {
+                memcpy(out, ":00000001FF\n", 12);
+                out += 12;
+            }
+            break;
+        case TextFormat_SRecord:
+        {
+            const size_t addr_max = addr - offset + total_size;
+            const int addr_bytes = (int)SRecordGetAddrBytes(addr_max);
+            const char* type = (addr_bytes == 2) ? "S1" : (addr_bytes == 3) ? "S2" : "S3";
+            for (size_t line_off = 0; line_off < size; line_off += 16)
+            {
+                const size_t count = (size - line_off < 16) ? size - line_off : 16;
+                const size_t rec_addr = addr + line_off;
+                ImU8 header[5];
+                header[0] = (ImU8)(addr_bytes + count + 1);
+                for (int n = 0; n < addr_bytes; n++)
+                    header[1 + n] = (ImU8)(rec_addr >> ((addr_bytes - 1 - n) * 8));
+                out = WriteHexRecord(out, type, header, 1 + addr_bytes, data + line_off, state + line_off, count, digits);
+            }
+            if (offset + size == total_size)
+            {
+                // Termination record with a start address of 0
+                const ImU8 header[5] = { (ImU8)(addr_bytes + 1), 0, 0, 0, 0 };
+                out = WriteHexRecord(out, (addr_bytes == 2) ? "S9" : (addr_bytes == 3) ? "S8" : "S7", header, 1 + addr_bytes, NULL, NULL, 0, digits);
+            }
+            break;
+        }
+        case TextFormat_Raw:
+            memcpy(out, data, size);
+            out += size;
+            break;
+        case TextFormat_Base64:
+        {
+            static const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (size_t n = 0; n < size; n += 3, out += 4)
+            {
+                const ImU32 b0 = (state[n] == ByteState_Valid) ? data[n] : 0;
+                const ImU32 b1 = (n + 1 < size && state[n + 1] == ByteState_Valid) ? data[n + 1] : 0;
+                const ImU32 b2 = (n + 2 < size && state[n + 2] == ByteState_Valid) ? data[n + 2] : 0;
+                const ImU32 v = (b0 << 16) | (b1 << 8) | b2;
+                out[0] = base64_chars[(v >> 18) & 0x3F];
+                out[1] = base64_chars[(v >> 12) & 0x3F];
+                out[2] = (n + 1 < size) ? base64_chars[(v >> 6) & 0x3F] : '=';
+                out[3] = (n + 2 < size) ? base64_chars[v & 0x3F] : '=';
+            }
+            break;
+        }
+        case TextFormat_PythonBytes:
+            if (offset == 0)
+            {
+                *out++ = 'b';
+                *out++ = '\'';
+            }
+            for (size_t n = 0; n < size; n++, out += 4)
+            {
+                const ImU8 b = (state[n] == ByteState_Valid) ? data[n] : 0;
+                out[0] = '\\';
+                out[1] = 'x';
+                out[2] = digits[b >> 4];
+                out[3] = digits[b & 0x0F];
+            }
+            if (offset + size == total_size)
+                *out++ = '\'';
+            break;
+        default:
+            IM_ASSERT(0);
+            break;
+        }
+        return (size_t)(out - out_begin);
+    }
+};
+
+// Sparse image made of regions at arbitrary addresses, e.g. firmware loaded from Intel HEX, Motorola S-record or xxd files with Load().
+// Only decoded bytes are held in memory. With CollapseGaps, gaps between regions are collapsed: each region starts on the row following
+// the previous one (rows are GapAlign bytes, set it to MemoryEditor::Cols), so that rows keep the address of their first byte.
+// Padding bytes are unreadable. Displayed addresses are given by GetAddr() and FindOffset().
+struct MemoryEditorSparseSource : MemoryEditorDataSource
+{
+    enum Format_
+    {
+        Format_Auto = 0,                // detected from the first line
+        Format_IntelHex,
+        Format_SRecord,
+        Format_Xxd
+    };
+
+    enum { ReadChunkSize = 1024 * 1024, MaxLineSize = 64 * 1024 };
+
+    struct Region
+    {
+        size_t  Addr;                   // address of the first byte
+        size_t  Size;
+        size_t  Offset;                 // offset in the source, after gaps are collapsed
+        size_t  DataOffset;             // offset in Data
+    };
+
+    ImVector<Region>    Regions;        // sorted by Addr, not overlapping
+    ImVector<ImU8>      Data;           // decoded bytes of all regions
+    size_t              Size;
+    size_t              StartAddr;      // from a start address record, (size_t)-1 if none
+    bool                CollapseGaps;   // = true   // set before Load(), or call Layout() after changing
+    size_t              GapAlign;       // = 16     // row size, to keep addresses of collapsed regions aligned
+    const char*         Error;          // last Load() error, NULL if none
+    size_t              ErrorLine;      // line of the last Load() error, 0 if none
+    size_t              UpperAddr;      // parser state: Intel HEX extended address
+    bool                EndOfFile;      // parser state: end of file record was read
+    bool                SkippedZeroes;  // parser state: xxd skipped lines of zeroes ("*" line)
+    ImVector<ImU8>      Record;         // parser state: decoded line
+
+    MemoryEditorSparseSource() { Size = 0; StartAddr = (size_t)-1; CollapseGaps = true; GapAlign = 16; Error = NULL; ErrorLine = 0; UpperAddr = 0; EndOfFile = SkippedZeroes = false; }
+
+    void Clear()
+    {
+        LockScope lock(this);
+        Regions.clear();
+        Data.clear();
+        Size = 0;
+        StartAddr = (size_t)-1;
+        Error = NULL;
+        ErrorLine = 0;
+        UpperAddr = 0;
+        EndOfFile = SkippedZeroes = false;
+    }
+
+    // Load a file, streamed ReadChunkSize bytes at a time. Record checksums are checked. On error return false with Error and ErrorLine set.
+    bool Load(const char* path, int format = Format_Auto)
+    {
+        LockScope lock(this);
+        Clear();
+        FILE* f = fopen(path, "rb");
+        if (f == NULL)
+            return SetError("can't open file", 0);
+        ImVector<char> buf;
+        buf.resize(ReadChunkSize + MaxLineSize);
+        Record.resize(MaxLineSize / 2);
+        size_t buf_size = 0;
+        size_t line_n = 0;
+        bool eof = false;
+        bool ok = true;
+        while (ok && !EndOfFile)
+        {
+            if (!eof)
+            {
+                const size_t read_size = fread(buf.Data + buf_size, 1, ReadChunkSize, f);
+                buf_size += read_size;
+                eof = (read_size < ReadChunkSize);
+            }
+            if (buf_size == 0)
+                break;
+
+            // Parse complete lines, keep the last partial line for the next chunk
+            const char* line = buf.Data;
+            const char* buf_end = buf.Data + buf_size;
+            while (ok && !EndOfFile && line < buf_end)
+            {
+                const char* line_end = (const char*)memchr(line, '\n', (size_t)(buf_end - line));
+                if (line_end == NULL && !eof)
+                    break;
+                if (line_end == NULL)
+                    line_end = buf_end;
+                line_n++;
+                size_t len = (size_t)(line_end - line);
+                if (len > 0 && line[len - 1] == '\r')
+                    len--;
+                if (len > 0)
+                {
+                    if (format == Format_Auto)
+                        format = (line[0] == ':') ? Format_IntelHex : (line[0] == 'S' && len > 1 && line[1] >= '0' && line[1] <= '9') ? Format_SRecord : Format_Xxd;
+                    const char* error = (format == Format_IntelHex) ? ParseIntelHexLine(line, len) : (format == Format_SRecord) ? ParseSRecordLine(line, len) : ParseXxdLine(line, len);
+                    if (error != NULL)
+                        ok = SetError(error, line_n);
+                }
+                line = (line_end < buf_end) ? line_end + 1 : buf_end;
+            }
+            buf_size = (size_t)(buf_end - line);
+            memmove(buf.Data, line, buf_size);
+            if (ok && buf_size >= MaxLineSize)
+                ok = SetError("line too long", line_n + 1);
+        }
+        if (ferror(f) && ok)
+            ok = SetError("read error", line_n);
+        fclose(f);
+        Record.clear();
+        if (ok)
+            ok = Finish();
+        if (!ok)
+        {
+            const char* error = Error;
+            const size_t error_line = ErrorLine;
+            Clear();
+            SetError(error, error_line);
+        }
+        return ok;
+    }
 
-#include <stdio.h>      // sprintf, scanf
-#include <stdint.h>     // uint8_t, etc.
+    // Add decoded bytes at 'addr', zeroes if 'src' is NULL. Call Finish() once all bytes were added.
+    bool AddBytes(size_t addr, const ImU8* src, size_t size)
+    {
+        LockScope lock(this);
+        if (size == 0)
+            return true;
+        if ((size_t)Data.Size + size > 0x7FFFFFFF)
+            return false;
+        Region* last = (Regions.Size > 0) ? &Regions.back() : NULL;
+        if (last != NULL && last->Addr + last->Size == addr && last->DataOffset + last->Size == (size_t)Data.Size)
+        {
+            last->Size += size;
+        }
+        else
+        {
+            Region region;
+            region.Addr = addr;
+            region.Size = size;
+            region.Offset = 0;
+            region.DataOffset = (size_t)Data.Size;
+            Regions.push_back(region);
+        }
+        const int data_size = Data.Size;
+        Data.resize(data_size + (int)size);
+        if (src != NULL)
+            memcpy(Data.Data + data_size, src, size);
+        else
+            memset(Data.Data + data_size, 0, size);
+        return true;
+    }
 
-#if defined(_MSC_VER) || defined(_UCRT)
-#define _PRISizeT   "I"
-#define ImSnprintf  _snprintf
-#else
-#define _PRISizeT   "z"
-#define ImSnprintf  snprintf
-#endif
+    // Sort regions, merge adjacent ones, release unused memory and lay regions out
+    bool Finish()
+    {
+        LockScope lock(this);
+        qsort(Regions.Data, (size_t)Regions.Size, sizeof(Region), CompareRegions);
+        int merged_count = 0;
+        for (int n = 0; n < Regions.Size; n++)
+        {
+            const Region& region = Regions[n];
+            Region* prev = (merged_count > 0) ? &Regions[merged_count - 1] : NULL;
+            if (prev != NULL && region.Addr < prev->Addr + prev->Size)
+                return SetError("overlapping records", 0);
+            if (prev != NULL && region.Addr == prev->Addr + prev->Size && region.DataOffset == prev->DataOffset + prev->Size)
+                prev->Size += region.Size;
+            else
+                Regions[merged_count++] = region;
+        }
+        Regions.resize(merged_count);
+        if (Data.Capacity > Data.Size + Data.Size / 8)
+        {
+            ImVector<ImU8> data;
+            data.reserve(Data.Size);
+            data.resize(Data.Size);
+            if (Data.Size > 0)
+                memcpy(data.Data, Data.Data, (size_t)Data.Size);
+            Data.swap(data);
+        }
+        Layout();
+        return true;
+    }
 
-#if defined(_MSC_VER) || defined(_UCRT)
-#pragma warning (push)
-#pragma warning (disable: 4996) // warning C4996: 'sprintf': This function or variable may be unsafe.
-#endif
+    // Compute Region::Offset
+    void Layout()
+    {
+        LockScope lock(this);
+        const size_t align = (GapAlign > 0) ? GapAlign : 1;
+        const size_t base_addr = (Regions.Size > 0) ? Regions[0].Addr - Regions[0].Addr % align : 0;
+        for (int n = 0; n < Regions.Size; n++)
+        {
+            Region& region = Regions[n];
+            if (n == 0 || !CollapseGaps)
+            {
+                region.Offset = region.Addr - base_addr;
+                continue;
+            }
+            const Region& prev = Regions[n - 1];
+            const size_t prev_end = prev.Offset + prev.Size;
+            const size_t gap_offset = prev_end + (region.Addr - (prev.Addr + prev.Size));
+            const size_t collapsed_offset = (prev_end + align - 1) / align * align + region.Addr % align;
+            region.Offset = (gap_offset < collapsed_offset) ? gap_offset : collapsed_offset;
+        }
+        Size = (Regions.Size > 0) ? Regions.back().Offset + Regions.back().Size : 0;
+    }
 
-struct MemoryEditor
-{
-    enum DataFormat
+    // Return index of the last region starting at or before 'off' (rows of padding before a region belong to it), -1 if none
+    int FindRegion(size_t off) const
     {
-        DataFormat_Bin = 0,
-        DataFormat_Dec = 1,
-        DataFormat_Hex = 2,
-        DataFormat_COUNT
-    };
+        const size_t align = (GapAlign > 0) ? GapAlign : 1;
+        int lo = 0, hi = Regions.Size;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if (Regions[mid].Offset - Regions[mid].Offset % align <= off)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo - 1;
+    }
+
+    size_t GetSize() override { return Size; }
+
+    size_t Read(size_t off, void* dst, size_t size) override
+    {
+        return Access(off, (ImU8*)dst, size, false);
+    }
+
+    size_t GetUnreadableSize(size_t off, size_t size) override
+    {
+        const int region_n = FindRegion(off);
+        size_t next_offset = Size;
+        for (int n = (region_n >= 0) ? region_n : 0; n < Regions.Size; n++)
+            if (Regions[n].Offset > off)
+            {
+                next_offset = Regions[n].Offset;
+                break;
+            }
+        const size_t skip_size = (next_offset > off) ? next_offset - off : 1;
+        return (skip_size < size) ? skip_size : size;
+    }
+
+    size_t Write(size_t off, const void* src, size_t size) override
+    {
+        return Access(off, (ImU8*)(void*)src, size, true);
+    }
+
+    size_t GetAddr(size_t off) override
+    {
+        if (Regions.Size == 0)
+            return off;
+        const int region_n = FindRegion(off);
+        const Region& region = Regions[(region_n >= 0) ? region_n : 0];
+        return region.Addr + off - region.Offset;
+    }
+
+    size_t FindOffset(size_t addr) override
+    {
+        int lo = 0, hi = Regions.Size;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if (Regions[mid].Addr <= addr)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo == 0 || addr - Regions[lo - 1].Addr >= Regions[lo - 1].Size)
+            return (size_t)-1;
+        return Regions[lo - 1].Offset + addr - Regions[lo - 1].Addr;
+    }
+
+    // Copy from/to the regions at 'off', stopping at the first padding byte
+    size_t Access(size_t off, ImU8* buf, size_t size, bool write)
+    {
+        size_t done = 0;
+        const int region_n = FindRegion(off);
+        for (int n = (region_n >= 0) ? region_n : 0; n < Regions.Size && done < size; n++)
+        {
+            Region& region = Regions[n];
+            const size_t pos = off + done;
+            if (pos < region.Offset || pos >= region.Offset + region.Size)
+            {
+                if (pos < region.Offset)
+                    break;
+                continue;
+            }
+            const size_t count = (region.Offset + region.Size - pos < size - done) ? region.Offset + region.Size - pos : size - done;
+            ImU8* data = Data.Data + region.DataOffset + (pos - region.Offset);
+            if (write)
+                memcpy(data, buf + done, count);
+            else
+                memcpy(buf + done, data, count);
+            done += count;
+        }
+        return done;
+    }
+
+    bool SetError(const char* error, size_t line_n)
+    {
+        Error = error;
+        ErrorLine = line_n;
+        return false;
+    }
+
+    static int CompareRegions(const void* lhs, const void* rhs)
+    {
+        const Region* a = (const Region*)lhs;
+        const Region* b = (const Region*)rhs;
+        return (a->Addr < b->Addr) ? -1 : (a->Addr > b->Addr) ? 1 : (a->DataOffset < b->DataOffset) ? -1 : (a->DataOffset > b->DataOffset) ? 1 : 0;
+    }
+
+    // Decode 'len' hex digits into Record, return number of bytes or (size_t)-1 if there's any other character
+    size_t DecodeRecord(const char* text, size_t len)
+    {
+        if ((len & 1) != 0)
+            return (size_t)-1;
+        const size_t size = MemoryEditorEngine::DecodeHex(text, len, Record.Data, NULL);
+        return (size * 2 == len) ? size : (size_t)-1;
+    }
+
+    // ":LLAAAATT<data>CC", checksum is the two's complement of the sum of bytes
+    const char* ParseIntelHexLine(const char* line, size_t len)
+    {
+        if (line[0] != ':')
+            return "record doesn't start with ':'";
+        const size_t size = DecodeRecord(line + 1, len - 1);
+        if (size == (size_t)-1 || size < 5 || Record[0] != size - 5)
+            return "invalid record";
+        ImU32 sum = 0;
+        for (size_t n = 0; n < size; n++)
+            sum += Record[n];
+        if ((sum & 0xFF) != 0)
+            return "checksum mismatch";
+        const ImU8* rec = Record.Data;
+        const size_t data_size = rec[0];
+        switch (rec[3])
+        {
+        case 0x00:
+            if (!AddBytes(UpperAddr + (((size_t)rec[1] << 8) | rec[2]), rec + 4, data_size))
+                return "image too large";
+            return NULL;
+        case 0x01:
+            EndOfFile = true;
+            return NULL;
+        case 0x02:
+        case 0x04:
+            if (data_size != 2)
+                return "invalid record";
+            UpperAddr = (((size_t)rec[4] << 8) | rec[5]) << ((rec[3] == 0x02) ? 4 : 16);
+            return NULL;
+        case 0x03:
+        case 0x05:
+            if (data_size != 4)
+                return "invalid record";
+            StartAddr = (rec[3] == 0x03) ? (((size_t)rec[4] << 8 | rec[5]) << 4) + ((size_t)rec[6] << 8 | rec[7]) : ((size_t)rec[4] << 24) | ((size_t)rec[5] << 16) | ((size_t)rec[6] << 8) | rec[7];
+            return NULL;
+        default:
+            return "unknown record type";
+        }
+    }
+
+    // "StCC<address><data>SS", checksum is the one's complement of the sum of bytes
+    const char* ParseSRecordLine(const char* line, size_t len)
+    {
+        if (len < 4 || line[0] != 'S' || line[1] < '0' || line[1] > '9')
+            return "record doesn't start with 'S'";
+        const size_t size = DecodeRecord(line + 2, len - 2);
+        if (size == (size_t)-1 || size < 2 || Record[0] != size - 1)
+            return "invalid record";
+        ImU32 sum = 0;
+        for (size_t n = 0; n < size; n++)
+            sum += Record[n];
+        if ((sum & 0xFF) != 0xFF)
+            return "checksum mismatch";
+        const int type = line[1] - '0';
+        const int addr_size = (type == 1 || type == 9) ? 2 : (type == 2 || type == 8) ? 3 : (type == 3 || type == 7) ? 4 : 0;
+        if (type == 4)
+            return "unknown record type";
+        if (addr_size == 0)                             // S0 header, S5/S6 record count
+            return NULL;
+        if (size < (size_t)addr_size + 2)
+            return "invalid record";
+        size_t addr = 0;
+        for (int n = 0; n < addr_size; n++)
+            addr = (addr << 8) | Record[1 + n];
+        if (type >= 7)
+            StartAddr = addr;
+        else if (!AddBytes(addr, Record.Data + 1 + addr_size, size - 2 - addr_size))
+            return "image too large";
+        return NULL;
+    }
+
+    // "<address>: <hex groups>  <ascii>", as written by xxd. A "*" line (xxd -a) stands for lines of zeroes up to the next address.
+    const char* ParseXxdLine(const char* line, size_t len)
+    {
+        if (line[0] == '*')
+        {
+            SkippedZeroes = true;
+            return NULL;
+        }
+        size_t addr = 0;
+        size_t n = 0;
+        for (; n < len && line[n] != ':'; n++)
+        {
+            const int value = MemoryEditorEngine::HexDigitValue(line[n]);
+            if (value < 0)
+                return "invalid address";
+            addr = (addr << 4) | (size_t)value;
+        }
+        if (n == 0 || n == len)
+            return "invalid address";
+        if (SkippedZeroes && Regions.Size > 0 && Regions.back().Addr + Regions.back().Size < addr)
+        {
+            const Region& last = Regions.back();
+            if (!AddBytes(last.Addr + last.Size, NULL, addr - (last.Addr + last.Size)))
+                return "image too large";
+        }
+        SkippedZeroes = false;
+        // Hex groups end with two spaces before the ascii column
+        size_t hex_begin = n + 1, hex_end = hex_begin + 1;
+        while (hex_end < len && !(line[hex_end] == ' ' && line[hex_end - 1] == ' '))
+            hex_end++;
+        const size_t size = MemoryEditorEngine::DecodeHex(line + hex_begin, hex_end - hex_begin, Record.Data, NULL);
+        if (size == (size_t)-1)
+            return "invalid hex data";
+        if (!AddBytes(addr, Record.Data, size))
+            return "image too large";
+        return NULL;
+    }
+};
 
+struct MemoryEditor : MemoryEditorEngine
+{
     // Settings
     bool            Open;                                       // = true   // set to false when DrawWindow() was closed. ignore if not using DrawWindow().
     bool            ReadOnly;                                   // = false  // disable any editing.
@@ -91,9 +5175,13 @@ struct MemoryEditor
     int             OptAddrDigitsCount;                         // = 0      // number of addr digits to display (default calculated based on maximum displayed addr).
     float           OptFooterExtraHeight;                       // = 0      // space to reserve at the bottom of the widget to add custom widgets
     ImU32           HighlightColor;                             //          // background color of highlighted bytes.
-    ImU8            (*ReadFn)(const ImU8* data, size_t off);    // = 0      // optional handler to read bytes.
-    void            (*WriteFn)(ImU8* data, size_t off, ImU8 d); // = 0      // optional handler to write bytes.
     bool            (*HighlightFn)(const ImU8* data, size_t off);//= 0      // optional handler to return Highlight property (to support non-contiguous highlighting).
+    MemoryEditorHexGlyphs* HexGlyphs;                           // = NULL   // optional pre-baked hex glyphs, used when the current font is the one they were built for.
+    bool            OptTrackAllocations;                        // = false  // count allocations made by the calling thread during DrawContents() in AllocStats.FrameAllocCount: through Allocator, and through ImGui::MemAlloc() once MemoryEditorAllocStats::InstallImGuiHooks() was called.
+    int             AllocCheckWarmupFrames;                     // = -1     // benchmark mode: when >= 0, allocations are tracked and any allocation made by DrawContents() after this number of frames sets AllocStats.CheckFailed and asserts.
+    ImU32           (*SnapshotVersionFn)(const ImU8* data);     // = 0      // optional handler returning a seqlock/version counter (odd while being written, use an acquire load). visible rows and previewed bytes are copied once per frame, retrying until the counter is even and unchanged.
+    TextFormat      CopyFormat;                                 // = TextFormat_Hex // format used by Ctrl+C on a selection.
+    TextFormat      ExportFormat;                               // = TextFormat_Xxd // format used by exports from the options menu.
 
     // [Internal State]
     bool            ContentsWidthChanged;
@@ -102,12 +5190,99 @@ struct MemoryEditor
     bool            DataEditingTakeFocus;
     char            DataInputBuf[32];
     char            AddrInputBuf[32];
+    char            ExportPathBuf[256];
+    char            FindInputBuf[64];
     size_t          GotoAddr;
     size_t          HighlightMin, HighlightMax;
+    size_t          SelectionAnchorAddr;                        // byte where the selection started (click), (size_t)-1 if none
+    size_t          SelectionCursorAddr;                        // byte where the selection ends (drag, shift+click), included
+    bool            SelectionDragging;
+    size_t          PasteErrorOffset;                           // offset of the invalid character of the last paste, (size_t)-1 if it succeeded
+    bool            TransformEditing;                           // transform bar is open: selected bytes are displayed transformed by PendingTransform until applied
+    bool            TransformKeyValid;
+    Transform       PendingTransform;
+    char            TransformKeyBuf[Transform::KeyMaxSize * 3 + 1];
     int             PreviewEndianness;
     ImGuiDataType   PreviewDataType;
+    MemoryEditorFrameArena FrameArena;                          // temporary buffers of the current frame, reset by DrawContents()
+    MemoryEditorAllocStats AllocStats;                          // allocation counters, readable by the host
+    ImU8*           RowData;                                    // bytes of the visible rows being drawn (FrameArena)
+    ImU8*           RowState;                                   // ByteState of the visible rows being drawn (FrameArena)
+    size_t          SnapshotPreviewAddr;                        // DataPreviewAddr when previewed bytes were copied along with visible rows this frame, else (size_t)-1
+    ImU8            SnapshotPreviewData[8];
+    ImU8            SnapshotPreviewState[8];
+    char*           RowGlyphs;                                  // FormatRow() output for a row which wasn't prepared ahead (FrameArena)
+    ImU8*           RowGlyphsDisabled;
+
+    // Rows formatted one frame ahead by a job, when JobSystem has threads. The UI thread only checks that their input bytes
+    // still match the visible rows and copies glyphs into the draw list. Rows of the next frame are predicted from the scrolling speed.
+    struct PreparedRows
+    {
+        int             LineMin, LineCount;
+        int             Cols, Flags;
+        size_t          MemSize;
+        ImVector<ImU8>  Data, State;            // input: LineCount * Cols bytes
+        ImVector<char>  Text;                   // output: FormatRow() text, LineCount * Cols * 3 (sized by the UI thread)
+        ImVector<ImU8>  Disabled;               // output: FormatRow() flags, LineCount * Cols * 2 (sized by the UI thread)
+
+        PreparedRows() { LineMin = LineCount = Cols = Flags = 0; MemSize = 0; }
+
+        static bool Step(MemoryEditorJob* job)
+        {
+            PreparedRows* rows = (PreparedRows*)job->UserData;
+            for (int line_n = 0; line_n < rows->LineCount; line_n++)
+            {
+                const size_t addr = (size_t)(rows->LineMin + line_n) * rows->Cols;
+                const int count = (rows->MemSize - addr < (size_t)rows->Cols) ? (int)(rows->MemSize - addr) : rows->Cols;
+                const size_t off = (size_t)line_n * rows->Cols;
+                FormatRow(rows->Data.Data + off, rows->State.Data + off, count, rows->Cols, rows->Flags, rows->Text.Data + off * 3, rows->Disabled.Data + off * 2);
+            }
+            return true;
+        }
+    };
+    struct RowPrepState
+    {
+        MemoryEditorJob Job;
+        PreparedRows    Rows[2];                // Rows[ReadyIdx] is read by the UI thread, the other one is written by Job
+        int             ReadyIdx;
+        bool            Submitted;
+        float           LastScrollY;
+
+        MemoryEditorMemoryBudget::Consumer Consumer;
+
+        RowPrepState() : Consumer("Prepared rows", MemoryEditorMemoryBudget::EvictPriority_Recomputable, EvictRows) { Job.StepFn = PreparedRows::Step; Job.Priority = MemoryEditorJob::Priority_Interactive; ReadyIdx = 0; Submitted = false; LastScrollY = 0.0f; }
+
+        size_t GetMemoryUsage() const
+        {
+            size_t usage = 0;
+            for (const PreparedRows& rows : Rows)
+                usage += (size_t)(rows.Data.Capacity + rows.State.Capacity + rows.Text.Capacity + rows.Disabled.Capacity);
+            return usage;
+        }
+
+        static size_t EvictRows(MemoryEditorMemoryBudget::Consumer* consumer, size_t)
+        {
+            RowPrepState* row_prep = (RowPrepState*)consumer->UserData;
+            if (row_prep->Job.IsBusy())
+                return 0;
+            const size_t released = consumer->Usage;
+            for (PreparedRows& rows : row_prep->Rows)
+            {
+                rows.Data.clear();
+                rows.State.clear();
+                rows.Text.clear();
+                rows.Disabled.clear();
+                rows.LineCount = 0;
+            }
+            row_prep->Submitted = false;
+            consumer->Usage = 0;
+            return released;
+        }
+    };
+    RowPrepState    RowPrep;
+    MemoryEditorMemoryBudget::Consumer FrameArenaConsumer;
 
-    MemoryEditor()
+    MemoryEditor() : FrameArenaConsumer("Frame buffers", MemoryEditorMemoryBudget::EvictPriority_Never)
     {
         // Settings
         Open = true;
@@ -123,9 +5298,13 @@ struct MemoryEditor
         OptAddrDigitsCount = 0;
         OptFooterExtraHeight = 0.0f;
         HighlightColor = IM_COL32(255, 255, 255, 50);
-        ReadFn = NULL;
-        WriteFn = NULL;
         HighlightFn = NULL;
+        HexGlyphs = NULL;
+        OptTrackAllocations = false;
+        AllocCheckWarmupFrames = -1;
+        SnapshotVersionFn = NULL;
+        CopyFormat = TextFormat_Hex;
+        ExportFormat = TextFormat_Xxd;
 
         // State/Internals
         ContentsWidthChanged = false;
@@ -133,11 +5312,23 @@ struct MemoryEditor
         DataEditingTakeFocus = false;
         memset(DataInputBuf, 0, sizeof(DataInputBuf));
         memset(AddrInputBuf, 0, sizeof(AddrInputBuf));
+        ImSnprintf(ExportPathBuf, IM_ARRAYSIZE(ExportPathBuf), "export.txt");
+        memset(FindInputBuf, 0, sizeof(FindInputBuf));
         GotoAddr = (size_t)-1;
         HighlightMin = HighlightMax = (size_t)-1;
+        SelectionAnchorAddr = SelectionCursorAddr = (size_t)-1;
+        SelectionDragging = false;
+        PasteErrorOffset = (size_t)-1;
+        TransformEditing = false;
+        TransformKeyValid = true;
+        memset(TransformKeyBuf, 0, sizeof(TransformKeyBuf));
         PreviewEndianness = 0;
         PreviewDataType = ImGuiDataType_S32;
+        SnapshotPreviewAddr = (size_t)-1;
+        RowData = RowState = RowGlyphsDisabled = NULL;
+        RowGlyphs = NULL;
     }
+    ~MemoryEditor() { CancelJob(&RowPrep.Job); }
 
     void GotoAddrAndHighlight(size_t addr_min, size_t addr_max)
     {
@@ -146,6 +5337,278 @@ struct MemoryEditor
         HighlightMax = addr_max;
     }
 
+    // Selection: [GetSelectionMin(), GetSelectionMax()), both (size_t)-1 when nothing is selected.
+    bool    HasSelection() const        { return SelectionAnchorAddr != (size_t)-1; }
+    size_t  GetSelectionMin() const     { return HasSelection() ? (SelectionAnchorAddr < SelectionCursorAddr ? SelectionAnchorAddr : SelectionCursorAddr) : (size_t)-1; }
+    size_t  GetSelectionMax() const     { return HasSelection() ? (SelectionAnchorAddr < SelectionCursorAddr ? SelectionCursorAddr : SelectionAnchorAddr) + 1 : (size_t)-1; }
+    void    SetSelection(size_t addr_min, size_t addr_max) { IM_ASSERT(addr_min < addr_max); SelectionAnchorAddr = addr_min; SelectionCursorAddr = addr_max - 1; }
+    void    ClearSelection()            { SelectionAnchorAddr = SelectionCursorAddr = (size_t)-1; SelectionDragging = false; }
+
+    // Paste hex text into the selected range (truncated to its size) or at the cursor, with a single WriteRange() call.
+    // Return false when the text isn't valid hex (see PasteErrorOffset) or there's no destination.
+    bool PasteHex(ImU8* mem_data, size_t mem_size, const char* text)
+    {
+        const bool paste_in_selection = HasSelection() && SelectionAnchorAddr != SelectionCursorAddr;
+        const size_t addr = paste_in_selection ? GetSelectionMin() : (DataEditingAddr != (size_t)-1) ? DataEditingAddr : GetSelectionMin();
+        if (ReadOnly || text == NULL || addr >= mem_size)
+            return false;
+        const size_t text_len = strlen(text);
+        ImU8* buf = (ImU8*)Allocator.Alloc(text_len / 2 + 1);
+        const size_t decoded_size = DecodeHex(text, text_len, buf, &PasteErrorOffset);
+        if (decoded_size != (size_t)-1)
+        {
+            PasteErrorOffset = (size_t)-1;
+            const size_t dst_size = paste_in_selection ? GetSelectionMax() - addr : mem_size - addr;
+            const size_t size = (decoded_size < dst_size) ? decoded_size : dst_size;
+            if (size > 0)
+                WriteRange(mem_data, addr, buf, size);
+            if (paste_in_selection || size == 0 || addr + size >= mem_size)
+            {
+                if (size > 0)
+                    SetSelection(addr, addr + size);
+                DataEditingAddr = (size_t)-1;
+            }
+            else
+            {
+                // Keep editing after the pasted bytes
+                DataEditingAddr = DataPreviewAddr = SelectionAnchorAddr = SelectionCursorAddr = addr + size;
+                DataEditingTakeFocus = true;
+            }
+        }
+        Allocator.Free(buf, text_len / 2 + 1);
+        return decoded_size != (size_t)-1;
+    }
+
+    // Open the transform bar for the selection, or apply/cancel the pending transform.
+    void    OpenTransform()             { TransformEditing = true; ImSnprintf(TransformKeyBuf, IM_ARRAYSIZE(TransformKeyBuf), "00"); ParseTransformKey(); }
+    void    CancelTransform()           { TransformEditing = false; }
+    size_t  ApplyPendingTransform(ImU8* mem_data)
+    {
+        size_t written = 0;
+        if (!ReadOnly && HasSelection() && TransformKeyValid)
+            written = ApplyTransform(mem_data, GetSelectionMin(), GetSelectionMax(), PendingTransform);
+        TransformEditing = false;
+        return written;
+    }
+    void ParseTransformKey()
+    {
+        ImU8 key[sizeof(TransformKeyBuf) / 2 + 1];
+        size_t err_offset;
+        const size_t key_size = DecodeHex(TransformKeyBuf, strlen(TransformKeyBuf), key, &err_offset);
+        TransformKeyValid = (key_size != (size_t)-1 && key_size > 0 && key_size <= Transform::KeyMaxSize);
+        if (TransformKeyValid)
+        {
+            PendingTransform.KeySize = (int)key_size;
+            memcpy(PendingTransform.Key, key, key_size);
+        }
+    }
+
+    // Display bytes [addr, addr+size) as they'd be after applying the pending transform to the selection.
+    void PreviewTransform(size_t addr, ImU8* data, size_t size) const
+    {
+        if (!TransformEditing || !TransformKeyValid || !HasSelection())
+            return;
+        const size_t sel_min = GetSelectionMin();
+        const size_t sel_max = GetSelectionMax();
+        const size_t preview_min = (addr > sel_min) ? addr : sel_min;
+        const size_t preview_max = (addr + size < sel_max) ? addr + size : sel_max;
+        if (preview_min < preview_max)
+            TransformBytes(PendingTransform, preview_min - sel_min, data + (preview_min - addr), preview_max - preview_min);
+    }
+
+    // Insert hex text before the cursor, or in place of the selected range. Requires a resizable Source.
+    bool InsertHex(const char* text)
+    {
+        const bool replace_selection = HasSelection() && SelectionAnchorAddr != SelectionCursorAddr;
+        const size_t addr = replace_selection ? GetSelectionMin() : (DataEditingAddr != (size_t)-1) ? DataEditingAddr : GetSelectionMin();
+        if (ReadOnly || text == NULL || addr == (size_t)-1 || !IsResizable())
+            return false;
+        const size_t text_len = strlen(text);
+        ImU8* buf = (ImU8*)Allocator.Alloc(text_len / 2 + 1);
+        const size_t decoded_size = DecodeHex(text, text_len, buf, &PasteErrorOffset);
+        bool ok = (decoded_size != (size_t)-1);
+        if (ok)
+        {
+            PasteErrorOffset = (size_t)-1;
+            if (replace_selection)
+                EraseRange(addr, GetSelectionMax() - addr);
+            ok = (decoded_size == 0) || InsertRange(addr, buf, decoded_size);
+            if (ok && decoded_size > 0)
+                SetSelection(addr, addr + decoded_size);
+            DataEditingAddr = (size_t)-1;
+        }
+        Allocator.Free(buf, text_len / 2 + 1);
+        return ok;
+    }
+
+    bool EraseSelection()
+    {
+        if (ReadOnly || !HasSelection() || !EraseRange(GetSelectionMin(), GetSelectionMax() - GetSelectionMin()))
+            return false;
+        DataEditingAddr = DataPreviewAddr = (size_t)-1;
+        ClearSelection();
+        return true;
+    }
+
+    // Copy selected bytes to the clipboard. Large selections are encoded by a job, and put in the clipboard once done.
+    void CopySelection(const void* mem_data, TextFormat format, int addr_digits, size_t base_display_addr)
+    {
+        if (HasSelection())
+            StartCopy(mem_data, GetSelectionMin(), GetSelectionMax(), format, Cols, addr_digits, base_display_addr, OptUpperCaseHex ? RowFormatFlags_UpperCaseHex : 0);
+    }
+
+    // Export [addr_min, addr_max) to ExportPathBuf in ExportFormat
+    bool ExportRange(const void* mem_data, size_t addr_min, size_t addr_max, int addr_digits, size_t base_display_addr)
+    {
+        if (addr_min >= addr_max || ExportPathBuf[0] == 0)
+            return false;
+        return StartExport(mem_data, addr_min, addr_max, ExportFormat, ExportPathBuf, Cols, addr_digits, base_display_addr, OptUpperCaseHex ? RowFormatFlags_UpperCaseHex : 0);
+    }
+
+    // Read rows [line_min, line_max) into RowData/RowState.
+    void FetchRows(const ImU8* mem_data, size_t mem_size, int line_min, int line_max)
+    {
+        const size_t addr_min = (size_t)line_min * Cols;
+        size_t addr_max = (size_t)line_max * Cols;
+        if (addr_max > mem_size)
+            addr_max = mem_size;
+        RowData = (ImU8*)FrameArena.Alloc((size_t)(line_max - line_min) * Cols);
+        RowState = (ImU8*)FrameArena.Alloc((size_t)(line_max - line_min) * Cols);
+
+        // Copy previewed bytes along with the first visible rows of the frame, so they come from the same snapshot
+        const size_t preview_addr = (OptShowDataPreview && SnapshotPreviewAddr == (size_t)-1) ? DataPreviewAddr : (size_t)-1;
+        const size_t preview_size = (preview_addr == (size_t)-1) ? 0 : (mem_size - preview_addr < 8) ? mem_size - preview_addr : 8;
+
+        // When SnapshotVersionFn is set, retry until the version is even and unchanged across the copy.
+        // Bytes read from the target only go to the cache once the copy is known to be consistent, so a torn copy is not served again by retries.
+        const int max_retries = 100;
+        const bool store = (SnapshotVersionFn == NULL);
+        for (int attempt = 0; ; attempt++)
+        {
+            const ImU32 version = SnapshotVersionFn ? SnapshotVersionFn(mem_data) : 0;
+            if ((version & 1) && attempt < max_retries)
+                continue;
+            ReadRange(mem_data, addr_min, RowData, RowState, addr_max - addr_min, store);
+            if (preview_size > 0)
+                ReadRange(mem_data, preview_addr, SnapshotPreviewData, SnapshotPreviewState, preview_size, store);
+            if (SnapshotVersionFn == NULL)
+                break;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (SnapshotVersionFn(mem_data) == version && (version & 1) == 0)
+            {
+                StoreRange(mem_data, addr_min, RowData, RowState, addr_max - addr_min);
+                if (preview_size > 0)
+                    StoreRange(mem_data, preview_addr, SnapshotPreviewData, SnapshotPreviewState, preview_size);
+                break;
+            }
+            if (attempt >= max_retries)
+                break;
+        }
+        PreviewTransform(addr_min, RowData, addr_max - addr_min);
+        if (preview_size > 0)
+        {
+            PreviewTransform(preview_addr, SnapshotPreviewData, preview_size);
+            SnapshotPreviewAddr = preview_addr;
+        }
+    }
+
+    bool IsRowPrepAsync() const
+    {
+#ifndef IMGUI_MEMORY_EDITOR_NO_THREADS
+        return JobSystem != NULL && JobSystem->GetThreadCount() > 0;
+#else
+        return false;
+#endif
+    }
+
+    // Return glyphs of a visible row: prepared ahead when its bytes didn't change, else formatted now.
+    bool GetRowGlyphs(int line_i, const ImU8* row_data, const ImU8* row_state, int count, int flags, size_t mem_size, const char** out_text, const ImU8** out_disabled)
+    {
+        const PreparedRows& ready = RowPrep.Rows[RowPrep.ReadyIdx];
+        const int line_n = line_i - ready.LineMin;
+        if (ready.Cols == Cols && ready.Flags == flags && ready.MemSize == mem_size && line_n >= 0 && line_n < ready.LineCount && ready.Text.Size > 0)
+        {
+            const size_t off = (size_t)line_n * Cols;
+            if (memcmp(ready.Data.Data + off, row_data, count) == 0 && memcmp(ready.State.Data + off, row_state, count) == 0)
+            {
+                *out_text = ready.Text.Data + off * 3;
+                *out_disabled = ready.Disabled.Data + off * 2;
+                return true;
+            }
+        }
+        if (RowGlyphs == NULL)
+        {
+            RowGlyphs = (char*)FrameArena.Alloc((size_t)Cols * 3);
+            RowGlyphsDisabled = (ImU8*)FrameArena.Alloc((size_t)Cols * 2);
+        }
+        FormatRow(row_data, row_state, count, Cols, flags, RowGlyphs, RowGlyphsDisabled);
+        *out_text = RowGlyphs;
+        *out_disabled = RowGlyphsDisabled;
+        return false;
+    }
+
+    // Submit formatting of [line_min, line_max) for next frame. Bytes of lines already fetched in RowData are reused.
+    // Other lines are read here and not by the job: reads go through the shared cache, Source or ReadFn, which are only used from the UI thread.
+    void SubmitRowPrep(const ImU8* mem_data, size_t mem_size, int line_min, int line_max, int fetched_line_min, int fetched_line_max, int flags)
+    {
+        PreparedRows& rows = RowPrep.Rows[RowPrep.ReadyIdx ^ 1];
+        rows.LineMin = line_min;
+        rows.LineCount = line_max - line_min;
+        rows.Cols = Cols;
+        rows.Flags = flags;
+        rows.MemSize = mem_size;
+        rows.Data.resize(rows.LineCount * Cols);
+        rows.State.resize(rows.LineCount * Cols);
+
+        // Lines overlapping the fetched ones are copied, lines before and after them are read with one ReadRange() each
+        const int copy_line_min = (fetched_line_min < line_min) ? line_min : (fetched_line_min > line_max) ? line_max : fetched_line_min;
+        const int copy_line_max = (fetched_line_max < copy_line_min) ? copy_line_min : (fetched_line_max > line_max) ? line_max : fetched_line_max;
+        const int span_lines[3][2] = { { line_min, copy_line_min }, { copy_line_min, copy_line_max }, { copy_line_max, line_max } };
+        for (int span_n = 0; span_n < 3; span_n++)
+        {
+            if (span_lines[span_n][0] >= span_lines[span_n][1])
+                continue;
+            const size_t addr = (size_t)span_lines[span_n][0] * Cols;
+            const size_t addr_max = (size_t)span_lines[span_n][1] * Cols;
+            const size_t count = ((addr_max < mem_size) ? addr_max : mem_size) - addr;
+            const size_t off = (size_t)(span_lines[span_n][0] - line_min) * Cols;
+            if (span_n == 1)
+            {
+                memcpy(rows.Data.Data + off, RowData + (size_t)(copy_line_min - fetched_line_min) * Cols, count);
+                memcpy(rows.State.Data + off, RowState + (size_t)(copy_line_min - fetched_line_min) * Cols, count);
+            }
+            else
+            {
+                ReadRange(mem_data, addr, rows.Data.Data + off, rows.State.Data + off, count);
+            }
+        }
+        rows.Text.resize(rows.LineCount * Cols * 3);       // sized here so the job doesn't allocate
+        rows.Disabled.resize(rows.LineCount * Cols * 2);
+        RowPrep.Job.UserData = &rows;
+        RowPrep.Submitted = true;
+        StartJob(&RowPrep.Job);
+    }
+
+    // Register memory held by the view and the engine with MemoryBudget, and release memory when over budget
+    void UpdateMemoryBudget()
+    {
+        MemoryEditorMemoryBudget::Attach(&RowPrep.Consumer, MemoryBudget, &RowPrep);
+        MemoryEditorMemoryBudget::Attach(&FrameArenaConsumer, MemoryBudget, &FrameArena);
+        if (MemoryBudget)
+        {
+            if (!RowPrep.Job.IsBusy())
+                RowPrep.Consumer.Usage = RowPrep.GetMemoryUsage();
+            FrameArenaConsumer.Usage = FrameArena.Capacity;
+        }
+        MemoryEditorEngine::UpdateMemoryBudget();
+    }
+
+    using MemoryEditorEngine::EndiannessCopy;
+    void* EndiannessCopy(void* dst, void* src, size_t size) const
+    {
+        return EndiannessCopy(dst, src, size, PreviewEndianness);
+    }
+
     struct Sizes
     {
         int     AddrDigitsCount;
@@ -167,7 +5630,7 @@ struct MemoryEditor
         ImGuiStyle& style = ImGui::GetStyle();
         s.AddrDigitsCount = OptAddrDigitsCount;
         if (s.AddrDigitsCount == 0)
-            for (size_t n = base_display_addr + mem_size - 1; n > 0; n >>= 4)
+            for (size_t n = base_display_addr + GetDisplayAddr(mem_size - 1); n > 0; n >>= 4)
                 s.AddrDigitsCount++;
         s.LineHeight = ImGui::GetTextLineHeight();
         s.GlyphWidth = ImGui::CalcTextSize("F").x + 1;                  // We assume the font is mono-space
@@ -207,8 +5670,44 @@ struct MemoryEditor
         ImGui::End();
     }
 
+    // Standalone Memory Editor window, displaying a data source
+    void DrawWindow(const char* title, MemoryEditorDataSource* source, size_t base_display_addr = 0x0000)
+    {
+        Source = source;
+        DrawWindow(title, NULL, source->GetSize(), base_display_addr);
+    }
+
+    // Memory Editor contents only, displaying a data source
+    void DrawContents(MemoryEditorDataSource* source, size_t base_display_addr = 0x0000)
+    {
+        Source = source;
+        DrawContents(NULL, source->GetSize(), base_display_addr);
+    }
+
     // Memory Editor contents only
     void DrawContents(void* mem_data_void, size_t mem_size, size_t base_display_addr = 0x0000)
+    {
+        Allocator.Stats = &AllocStats;
+        const bool track_allocations = OptTrackAllocations || AllocCheckWarmupFrames >= 0;
+        if (!track_allocations)
+        {
+            DrawContentsImpl(mem_data_void, mem_size, base_display_addr);
+            return;
+        }
+
+        // Counted per thread: allocations made meanwhile by job threads or other threads of the application are ignored
+        const int thread_alloc_count = MemoryEditorAllocStats::GetThreadAllocCount();
+        DrawContentsImpl(mem_data_void, mem_size, base_display_addr);
+        AllocStats.FrameAllocCount = MemoryEditorAllocStats::GetThreadAllocCount() - thread_alloc_count;
+        AllocStats.FrameCount++;
+        if (AllocCheckWarmupFrames >= 0 && AllocStats.FrameCount > AllocCheckWarmupFrames && AllocStats.FrameAllocCount > 0)
+        {
+            AllocStats.CheckFailed = true;
+            IM_ASSERT(0 && "MemoryEditor: DrawContents() allocated memory after warm-up");
+        }
+    }
+
+    void DrawContentsImpl(void* mem_data_void, size_t mem_size, size_t base_display_addr)
     {
         if (Cols < 1)
             Cols = 1;
@@ -228,6 +5727,10 @@ struct MemoryEditor
             footer_height += height_separator + ImGui::GetFrameHeightWithSpacing() * 1;
         if (OptShowDataPreview)
             footer_height += height_separator + ImGui::GetFrameHeightWithSpacing() * 1 + ImGui::GetTextLineHeightWithSpacing() * 3;
+        if (TransformEditing && (ReadOnly || !HasSelection()))
+            TransformEditing = false;
+        if (TransformEditing)
+            footer_height += height_separator + ImGui::GetFrameHeightWithSpacing() * 1;
         ImGui::BeginChild("##scrolling", ImVec2(-FLT_MIN, -footer_height), ImGuiChildFlags_None, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoNav);
         ImDrawList* draw_list = ImGui::GetWindowDrawList();
 
@@ -245,9 +5748,76 @@ struct MemoryEditor
             DataEditingAddr = (size_t)-1;
         if (DataPreviewAddr >= mem_size)
             DataPreviewAddr = (size_t)-1;
+        if (HasSelection() && (SelectionAnchorAddr >= mem_size || SelectionCursorAddr >= mem_size))
+            ClearSelection();
 
         size_t preview_data_type_size = OptShowDataPreview ? DataTypeGetSize(PreviewDataType) : 0;
 
+        FrameArena.SetAllocator(Allocator);
+        FrameArena.Reset();
+        RowData = RowState = RowGlyphsDisabled = NULL;
+        RowGlyphs = NULL;
+        UpdateMemoryBudget();
+        UpdateCache(mem_data, mem_size, ImGui::GetTime(), ImGui::GetFrameCount());
+        SharedState& shared = GetShared();
+        const size_t data_offset = GetDataOffset(mem_data);
+        SnapshotPreviewAddr = (size_t)-1;
+        if (TimeSlicedJobs.Size > 0)
+            RunTimeSlicedJobs(JobTimeBudget);
+        if (Search.ResultPending && !Search.Job.IsBusy())
+        {
+            if (Search.Job.State == MemoryEditorJob::State_Done && Search.ResultAddr != (size_t)-1)
+            {
+                // Other views showing the match highlight it too
+                GotoAddrAndHighlight(Search.ResultAddr, Search.ResultAddr + Search.Pattern.Size);
+                shared.SearchMatch.Min = Search.DataOffset + Search.ResultAddr;
+                shared.SearchMatch.Max = shared.SearchMatch.Min + Search.Pattern.Size;
+                shared.SearchMatch.Color = HighlightColor;
+            }
+            Search.ResultPending = false;
+        }
+        if (Copy.ResultPending && !Copy.Job.IsBusy())
+        {
+            if (Copy.Job.State == MemoryEditorJob::State_Done)
+                ImGui::SetClipboardText(Copy.Text);
+            Copy.ReleaseText();
+        }
+        if (Export.ResultPending && !Export.Job.IsBusy())
+            FinishExport();
+
+        if (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && ImGui::IsKeyPressed(ImGuiKey_F5, false))
+            Refresh();
+        if (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && ImGui::GetIO().KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_C, false) && DataEditingAddr == (size_t)-1)
+            CopySelection(mem_data, CopyFormat, s.AddrDigitsCount, base_display_addr);
+        if (!ReadOnly && ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && ImGui::GetIO().KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_V, false) && (DataEditingAddr != (size_t)-1 || HasSelection()))
+        {
+            // Before drawing the byte InputText, which would paste into itself otherwise. Ctrl+Shift+V inserts.
+            if (ImGui::GetIO().KeyShift && IsResizable())
+                InsertHex(ImGui::GetClipboardText());
+            else
+                PasteHex(mem_data, mem_size, ImGui::GetClipboardText());
+        }
+        if (!ReadOnly && IsResizable() && ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && ImGui::IsKeyPressed(ImGuiKey_Delete, false) && HasSelection())
+            EraseSelection();
+        if (!ReadOnly && ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && ImGui::GetIO().KeyCtrl)
+        {
+            if (ImGui::IsKeyPressed(ImGuiKey_Z) && !ImGui::GetIO().KeyShift)
+                Undo(mem_data, mem_size);
+            else if (ImGui::IsKeyPressed(ImGuiKey_Y) || (ImGui::IsKeyPressed(ImGuiKey_Z) && ImGui::GetIO().KeyShift))
+                Redo(mem_data, mem_size);
+        }
+
+        // Use rows prepared by the job submitted last frame
+        if (RowPrep.Submitted && !RowPrep.Job.IsBusy())
+        {
+            if (RowPrep.Job.State == MemoryEditorJob::State_Done)
+                RowPrep.ReadyIdx ^= 1;
+            RowPrep.Submitted = false;
+        }
+        const int row_format_flags = (OptUpperCaseHex ? RowFormatFlags_UpperCaseHex : 0) | (OptShowHexII ? RowFormatFlags_HexII : 0) | (OptGreyOutZeroes ? RowFormatFlags_GreyOutZeroes : 0);
+        int fetched_line_min = 0, fetched_line_max = 0;
+        bool all_rows_prepared = true;
+
         size_t data_editing_addr_next = (size_t)-1;
         if (DataEditingAddr != (size_t)-1)
         {
@@ -264,18 +5834,50 @@ struct MemoryEditor
             draw_list->AddLine(ImVec2(window_pos.x + s.PosAsciiStart - s.GlyphWidth, window_pos.y), ImVec2(window_pos.x + s.PosAsciiStart - s.GlyphWidth, window_pos.y + 9999), ImGui::GetColorU32(ImGuiCol_Border));
 
         const ImU32 color_text = ImGui::GetColorU32(ImGuiCol_Text);
-        const ImU32 color_disabled = OptGreyOutZeroes ? ImGui::GetColorU32(ImGuiCol_TextDisabled) : color_text;
+        const ImU32 color_text_disabled = ImGui::GetColorU32(ImGuiCol_TextDisabled);
+        const ImU32 color_disabled = OptGreyOutZeroes ? color_text_disabled : color_text;
+        const float row_base_x = window_pos.x - ImGui::GetScrollX();
+        // Click selects a byte (and edits it), drag or shift+click extends the selection
+        const bool mouse_clicked = ImGui::IsWindowHovered() && ImGui::IsMouseClicked(0);
+        if (SelectionDragging && !ImGui::IsMouseDown(0))
+            SelectionDragging = false;
+        const bool mouse_selecting = mouse_clicked || SelectionDragging;
+        const float mouse_x = ImGui::GetIO().MousePos.x, mouse_y = ImGui::GetIO().MousePos.y;
+        size_t mouse_addr = (size_t)-1;
+        const size_t selection_min = GetSelectionMin(), selection_max = GetSelectionMax();
+        const ImU32 color_selection = ImGui::GetColorU32(ImGuiCol_TextSelectedBg);
+        const MemoryEditorHexGlyphs* hex_glyphs = (HexGlyphs && HexGlyphs->IsUsable()) ? HexGlyphs : NULL;
+        const float font_size = ImGui::GetFontSize();
 
         const char* format_address = OptUpperCaseHex ? "%0*" _PRISizeT "X: " : "%0*" _PRISizeT "x: ";
         const char* format_data = OptUpperCaseHex ? "%0*" _PRISizeT "X" : "%0*" _PRISizeT "x";
         const char* format_byte = OptUpperCaseHex ? "%02X" : "%02x";
-        const char* format_byte_space = OptUpperCaseHex ? "%02X " : "%02x ";
 
         while (clipper.Step())
             for (int line_i = clipper.DisplayStart; line_i < clipper.DisplayEnd; line_i++) // display only visible lines
             {
                 size_t addr = (size_t)(line_i * Cols);
-                ImGui::Text(format_address, s.AddrDigitsCount, base_display_addr + addr);
+                const float row_y = ImGui::GetCursorScreenPos().y;
+                ImGui::Text(format_address, s.AddrDigitsCount, base_display_addr + GetDisplayAddr(addr));
+
+                // Fetch contents of all visible rows at once (a single read lets data sources provide a consistent snapshot)
+                if (line_i == clipper.DisplayStart)
+                {
+                    FetchRows(mem_data, mem_size, clipper.DisplayStart, clipper.DisplayEnd);
+                    fetched_line_min = clipper.DisplayStart;
+                    fetched_line_max = clipper.DisplayEnd;
+                }
+                const size_t row_addr = addr;
+                const ImU8* row_data = RowData + (size_t)(line_i - clipper.DisplayStart) * Cols;
+                const ImU8* row_state = RowState + (size_t)(line_i - clipper.DisplayStart) * Cols;
+                const int row_count = (mem_size - row_addr < (size_t)Cols) ? (int)(mem_size - row_addr) : Cols;
+                const char* row_text;
+                const ImU8* row_disabled;
+                if (!GetRowGlyphs(line_i, row_data, row_state, row_count, row_format_flags, mem_size, &row_text, &row_disabled))
+                    all_rows_prepared = false;
+                const bool row_selecting = mouse_selecting && mouse_y >= row_y && mouse_y < row_y + s.LineHeight;
+                const bool row_shared_highlights = shared.HasHighlights() && shared.HasHighlightsIn(data_offset + row_addr, data_offset + row_addr + row_count);
+                bool is_next_highlight_from_user_func = (HighlightFn && row_count > 0 && HighlightFn(mem_data, row_addr)); // HighlightFn is called once per byte
 
                 // Draw Hexadecimal
                 for (int n = 0; n < Cols && addr < mem_size; n++, addr++)
@@ -283,17 +5885,31 @@ struct MemoryEditor
                     float byte_pos_x = s.PosHexStart + s.HexCellWidth * n;
                     if (OptMidColsCount > 0)
                         byte_pos_x += (float)(n / OptMidColsCount) * s.SpacingBetweenMidCols;
-                    ImGui::SameLine(byte_pos_x);
+                    const ImVec2 byte_pos(row_base_x + byte_pos_x, row_y);
 
                     // Draw highlight
                     bool is_highlight_from_user_range = (addr >= HighlightMin && addr < HighlightMax);
-                    bool is_highlight_from_user_func = (HighlightFn && HighlightFn(mem_data, addr));
+                    bool is_highlight_from_user_func = is_next_highlight_from_user_func;
+                    is_next_highlight_from_user_func = (HighlightFn && n + 1 < row_count && HighlightFn(mem_data, addr + 1));
                     bool is_highlight_from_preview = (addr >= DataPreviewAddr && addr < DataPreviewAddr + preview_data_type_size);
+                    const HighlightRange* shared_highlight = row_shared_highlights ? shared.FindHighlight(data_offset + addr) : NULL;
+                    if (shared_highlight && !is_highlight_from_user_range && !is_highlight_from_preview)
+                    {
+                        ImVec2 pos = byte_pos;
+                        float highlight_width = s.GlyphWidth * 2;
+                        if ((data_offset + addr + 1 < shared_highlight->Max) || (n + 1 == Cols))
+                        {
+                            highlight_width = s.HexCellWidth;
+                            if (OptMidColsCount > 0 && n > 0 && (n + 1) < Cols && ((n + 1) % OptMidColsCount) == 0)
+                                highlight_width += s.SpacingBetweenMidCols;
+                        }
+                        draw_list->AddRectFilled(pos, ImVec2(pos.x + highlight_width, pos.y + s.LineHeight), shared_highlight->Color);
+                    }
                     if (is_highlight_from_user_range || is_highlight_from_user_func || is_highlight_from_preview)
                     {
-                        ImVec2 pos = ImGui::GetCursorScreenPos();
+                        ImVec2 pos = byte_pos;
                         float highlight_width = s.GlyphWidth * 2;
-                        bool is_next_byte_highlighted = (addr + 1 < mem_size) && ((HighlightMax != (size_t)-1 && addr + 1 < HighlightMax) || (HighlightFn && HighlightFn(mem_data, addr + 1)));
+                        bool is_next_byte_highlighted = (addr + 1 < mem_size) && ((HighlightMax != (size_t)-1 && addr + 1 < HighlightMax) || is_next_highlight_from_user_func);
                         if (is_next_byte_highlighted || (n + 1 == Cols))
                         {
                             highlight_width = s.HexCellWidth;
@@ -302,17 +5918,36 @@ struct MemoryEditor
                         }
                         draw_list->AddRectFilled(pos, ImVec2(pos.x + highlight_width, pos.y + s.LineHeight), HighlightColor);
                     }
+                    if (addr >= selection_min && addr < selection_max && addr != DataEditingAddr)
+                    {
+                        float highlight_width = s.GlyphWidth * 2;
+                        if (addr + 1 < selection_max || (n + 1 == Cols))
+                        {
+                            highlight_width = s.HexCellWidth;
+                            if (OptMidColsCount > 0 && n > 0 && (n + 1) < Cols && ((n + 1) % OptMidColsCount) == 0)
+                                highlight_width += s.SpacingBetweenMidCols;
+                        }
+                        draw_list->AddRectFilled(byte_pos, ImVec2(byte_pos.x + highlight_width, byte_pos.y + s.LineHeight), color_selection);
+                    }
+
+                    // The clickable cell includes the trailing space so there's no gap that the mouse cannot click on.
+                    if (row_selecting && mouse_x >= byte_pos.x && mouse_x < byte_pos.x + s.HexCellWidth)
+                        mouse_addr = addr;
 
                     if (DataEditingAddr == addr)
                     {
                         // Display text input on current byte
                         bool data_write = false;
+                        ImGui::SameLine(byte_pos_x);
                         ImGui::PushID((void*)addr);
                         if (DataEditingTakeFocus)
                         {
                             ImGui::SetKeyboardFocusHere(0);
-                            ImSnprintf(AddrInputBuf, 32, format_data, s.AddrDigitsCount, base_display_addr + addr);
-                            ImSnprintf(DataInputBuf, 32, format_byte, ReadFn ? ReadFn(mem_data, addr) : mem_data[addr]);
+                            ImSnprintf(AddrInputBuf, 32, format_data, s.AddrDigitsCount, base_display_addr + GetDisplayAddr(addr));
+                            if (row_state[n] == ByteState_Valid)
+                                ImSnprintf(DataInputBuf, 32, format_byte, row_data[n]);
+                            else
+                                ImSnprintf(DataInputBuf, 32, (row_state[n] == ByteState_Unreadable) ? "??" : "--");
                         }
                         struct UserData
                         {
@@ -339,7 +5974,10 @@ struct MemoryEditor
                         };
                         UserData user_data;
                         user_data.CursorPos = -1;
-                        ImSnprintf(user_data.CurrentBufOverwrite, 3, format_byte, ReadFn ? ReadFn(mem_data, addr) : mem_data[addr]);
+                        if (row_state[n] == ByteState_Valid)
+                            ImSnprintf(user_data.CurrentBufOverwrite, 3, format_byte, row_data[n]);
+                        else
+                            ImSnprintf(user_data.CurrentBufOverwrite, 3, (row_state[n] == ByteState_Unreadable) ? "??" : "--");
                         ImGuiInputTextFlags flags = ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_AutoSelectAll | ImGuiInputTextFlags_NoHorizontalScroll | ImGuiInputTextFlags_CallbackAlways;
                         flags |= ImGuiInputTextFlags_AlwaysOverwrite; // was ImGuiInputTextFlags_AlwaysInsertMode
                         ImGui::SetNextItemWidth(s.GlyphWidth * 2);
@@ -354,42 +5992,16 @@ struct MemoryEditor
                             data_write = data_next = false;
                         unsigned int data_input_value = 0;
                         if (data_write && sscanf(DataInputBuf, "%X", &data_input_value) == 1)
-                        {
-                            if (WriteFn)
-                                WriteFn(mem_data, addr, (ImU8)data_input_value);
-                            else
-                                mem_data[addr] = (ImU8)data_input_value;
-                        }
+                            WriteByte(mem_data, addr, (ImU8)data_input_value);
                         ImGui::PopID();
                     }
                     else
                     {
-                        // NB: The trailing space is not visible but ensure there's no gap that the mouse cannot click on.
-                        ImU8 b = ReadFn ? ReadFn(mem_data, addr) : mem_data[addr];
-
-                        if (OptShowHexII)
-                        {
-                            if ((b >= 32 && b < 128))
-                                ImGui::Text(".%c ", b);
-                            else if (b == 0xFF && OptGreyOutZeroes)
-                                ImGui::TextDisabled("## ");
-                            else if (b == 0x00)
-                                ImGui::Text("   ");
-                            else
-                                ImGui::Text(format_byte_space, b);
-                        }
+                        const ImWchar hex_glyph = hex_glyphs ? hex_glyphs->GetCodepoint(row_text[n * 2], row_text[n * 2 + 1]) : 0;
+                        if (hex_glyph != 0)
+                            hex_glyphs->Font->RenderChar(draw_list, font_size, byte_pos, row_disabled[n] ? color_text_disabled : color_text, hex_glyph);
                         else
-                        {
-                            if (b == 0 && OptGreyOutZeroes)
-                                ImGui::TextDisabled("00 ");
-                            else
-                                ImGui::Text(format_byte_space, b);
-                        }
-                        if (!ReadOnly && ImGui::IsItemHovered() && ImGui::IsMouseClicked(0))
-                        {
-                            DataEditingTakeFocus = true;
-                            data_editing_addr_next = addr;
-                        }
+                            draw_list->AddText(byte_pos, row_disabled[n] ? color_text_disabled : color_text, row_text + n * 2, row_text + n * 2 + 2);
                     }
                 }
 
@@ -398,28 +6010,82 @@ struct MemoryEditor
                     // Draw ASCII values
                     ImGui::SameLine(s.PosAsciiStart);
                     ImVec2 pos = ImGui::GetCursorScreenPos();
-                    addr = line_i * Cols;
+                    addr = row_addr;
                     ImGui::PushID(line_i);
-                    if (ImGui::InvisibleButton("ascii", ImVec2(s.PosAsciiEnd - s.PosAsciiStart, s.LineHeight)))
+                    ImGui::InvisibleButton("ascii", ImVec2(s.PosAsciiEnd - s.PosAsciiStart, s.LineHeight)); // clicks are handled with the hex cells, this prevents moving the window
+                    ImGui::PopID();
+                    if (row_selecting && mouse_x >= pos.x && mouse_x < pos.x + s.GlyphWidth * row_count)
+                        mouse_addr = row_addr + (size_t)((mouse_x - pos.x) / s.GlyphWidth);
+                    if (selection_min < row_addr + row_count && selection_max > row_addr)
                     {
-                        DataEditingAddr = DataPreviewAddr = addr + (size_t)((ImGui::GetIO().MousePos.x - pos.x) / s.GlyphWidth);
-                        DataEditingTakeFocus = true;
+                        const size_t sel_min = (selection_min > row_addr) ? selection_min : row_addr;
+                        const size_t sel_max = (selection_max < row_addr + row_count) ? selection_max : row_addr + row_count;
+                        draw_list->AddRectFilled(ImVec2(pos.x + s.GlyphWidth * (float)(sel_min - row_addr), pos.y), ImVec2(pos.x + s.GlyphWidth * (float)(sel_max - row_addr), pos.y + s.LineHeight), color_selection);
                     }
-                    ImGui::PopID();
-                    for (int n = 0; n < Cols && addr < mem_size; n++, addr++)
+                    if (DataEditingAddr >= row_addr && DataEditingAddr < row_addr + row_count)
                     {
-                        if (addr == DataEditingAddr)
-                        {
-                            draw_list->AddRectFilled(pos, ImVec2(pos.x + s.GlyphWidth, pos.y + s.LineHeight), ImGui::GetColorU32(ImGuiCol_FrameBg));
-                            draw_list->AddRectFilled(pos, ImVec2(pos.x + s.GlyphWidth, pos.y + s.LineHeight), ImGui::GetColorU32(ImGuiCol_TextSelectedBg));
-                        }
-                        unsigned char c = ReadFn ? ReadFn(mem_data, addr) : mem_data[addr];
-                        char display_c = (c < 32 || c >= 128) ? '.' : c;
-                        draw_list->AddText(pos, (display_c == c) ? color_text : color_disabled, &display_c, &display_c + 1);
-                        pos.x += s.GlyphWidth;
+                        const ImVec2 edit_pos(pos.x + s.GlyphWidth * (float)(DataEditingAddr - row_addr), pos.y);
+                        draw_list->AddRectFilled(edit_pos, ImVec2(edit_pos.x + s.GlyphWidth, edit_pos.y + s.LineHeight), ImGui::GetColorU32(ImGuiCol_FrameBg));
+                        draw_list->AddRectFilled(edit_pos, ImVec2(edit_pos.x + s.GlyphWidth, edit_pos.y + s.LineHeight), ImGui::GetColorU32(ImGuiCol_TextSelectedBg));
+                    }
+                    // Draw runs of glyphs sharing a color
+                    const char* ascii_text = row_text + Cols * 2;
+                    const ImU8* ascii_disabled = row_disabled + Cols;
+                    for (int n = 0; n < row_count; )
+                    {
+                        int n_end = n + 1;
+                        while (n_end < row_count && ascii_disabled[n_end] == ascii_disabled[n])
+                            n_end++;
+                        draw_list->AddText(ImVec2(pos.x + s.GlyphWidth * n, pos.y), ascii_disabled[n] ? color_disabled : color_text, ascii_text + n, ascii_text + n_end);
+                        n = n_end;
                     }
                 }
             }
+
+        // Prepare rows of next frame: the visible rows moved by the distance scrolled this frame
+        if (IsRowPrepAsync() && !RowPrep.Job.IsBusy() && fetched_line_max > fetched_line_min)
+        {
+            const float scroll_y = ImGui::GetScrollY();
+            const float scroll_lines = (scroll_y - RowPrep.LastScrollY) / s.LineHeight;
+            const int scroll_lines_i = (int)(scroll_lines < 0.0f ? scroll_lines - 1.0f : scroll_lines + 1.0f);
+            RowPrep.LastScrollY = scroll_y;
+            if (!all_rows_prepared || scroll_lines != 0.0f)
+            {
+                int line_min = fetched_line_min + ((scroll_lines != 0.0f) ? scroll_lines_i : 0);
+                int line_max = fetched_line_max + ((scroll_lines != 0.0f) ? scroll_lines_i : 0);
+                line_min = (line_min < 0) ? 0 : (line_min > line_total_count) ? line_total_count : line_min;
+                line_max = (line_max < line_min) ? line_min : (line_max > line_total_count) ? line_total_count : line_max;
+                if (line_max > line_min)
+                    SubmitRowPrep(mem_data, mem_size, line_min, line_max, fetched_line_min, fetched_line_max, row_format_flags);
+            }
+        }
+
+        // Apply clicks and drags
+        if (mouse_addr != (size_t)-1)
+        {
+            if (!mouse_clicked)
+            {
+                SelectionCursorAddr = mouse_addr;
+            }
+            else if (ImGui::GetIO().KeyShift && HasSelection())
+            {
+                SelectionCursorAddr = mouse_addr;
+                SelectionDragging = true;
+            }
+            else
+            {
+                SelectionAnchorAddr = SelectionCursorAddr = DataPreviewAddr = mouse_addr;
+                SelectionDragging = true;
+                PasteErrorOffset = (size_t)-1;
+                if (!ReadOnly && mouse_addr != DataEditingAddr)
+                    data_editing_addr_next = mouse_addr;
+            }
+        }
+        if (HasSelection() && SelectionAnchorAddr != SelectionCursorAddr)
+            DataEditingAddr = data_editing_addr_next = (size_t)-1; // no byte editing while a range is selected
+        else if (HasSelection() && ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && ImGui::IsKeyPressed(ImGuiKey_Escape, false))
+            ClearSelection();
+
         ImGui::PopStyleVar(2);
         const float child_width = ImGui::GetWindowSize().x;
         ImGui::EndChild();
@@ -430,16 +6096,21 @@ struct MemoryEditor
 
         if (data_next && DataEditingAddr + 1 < mem_size)
         {
-            DataEditingAddr = DataPreviewAddr = DataEditingAddr + 1;
+            DataEditingAddr = DataPreviewAddr = SelectionAnchorAddr = SelectionCursorAddr = DataEditingAddr + 1;
             DataEditingTakeFocus = true;
         }
         else if (data_editing_addr_next != (size_t)-1)
         {
-            DataEditingAddr = DataPreviewAddr = data_editing_addr_next;
+            DataEditingAddr = DataPreviewAddr = SelectionAnchorAddr = SelectionCursorAddr = data_editing_addr_next;
             DataEditingTakeFocus = true;
         }
 
         const bool lock_show_data_preview = OptShowDataPreview;
+        if (TransformEditing)
+        {
+            ImGui::Separator();
+            DrawTransformLine(s, mem_data);
+        }
         if (OptShowOptions)
         {
             ImGui::Separator();
@@ -468,14 +6139,124 @@ struct MemoryEditor
             if (ImGui::Checkbox("Show Ascii", &OptShowAscii)) { ContentsWidthChanged = true; }
             ImGui::Checkbox("Grey out zeroes", &OptGreyOutZeroes);
             ImGui::Checkbox("Uppercase Hex", &OptUpperCaseHex);
+            ImGui::SetNextItemWidth(s.GlyphWidth * 20 + style.FramePadding.x * 2.0f);
+            ImGui::DragFloat("##refresh_rate", &RefreshRate, 0.1f, 0.0f, 240.0f, RefreshRate > 0.0f ? "Refresh %.1f Hz" : "Refresh every frame");
+            ImGui::SetNextItemWidth(s.GlyphWidth * 20 + style.FramePadding.x * 2.0f);
+            if (ImGui::BeginCombo("##copy_format", TextFormatGetDesc(CopyFormat)))
+            {
+                for (int n = 0; n < TextFormat_Raw; n++)
+                    if (ImGui::Selectable(TextFormatGetDesc((TextFormat)n), CopyFormat == n))
+                        CopyFormat = (TextFormat)n;
+                ImGui::EndCombo();
+            }
+
+            // Export
+            ImGui::Separator();
+            ImGui::SetNextItemWidth(s.GlyphWidth * 20 + style.FramePadding.x * 2.0f);
+            if (ImGui::BeginCombo("##export_format", TextFormatGetDesc(ExportFormat)))
+            {
+                for (int n = 0; n < TextFormat_COUNT; n++)
+                    if (ImGui::Selectable(TextFormatGetDesc((TextFormat)n), ExportFormat == n))
+                        ExportFormat = (TextFormat)n;
+                ImGui::EndCombo();
+            }
+            ImGui::SetNextItemWidth(s.GlyphWidth * 32 + style.FramePadding.x * 2.0f);
+            ImGui::InputText("##export_path", ExportPathBuf, IM_ARRAYSIZE(ExportPathBuf));
+            if (!Export.Job.IsBusy())
+            {
+                if (HasSelection() && ImGui::Selectable("Export selection"))
+                    ExportRange(mem_data, GetSelectionMin(), GetSelectionMax(), s.AddrDigitsCount, base_display_addr);
+                if (ImGui::Selectable("Export all"))
+                    ExportRange(mem_data, 0, mem_size, s.AddrDigitsCount, base_display_addr);
+                if (Export.Failed)
+                    ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Export to '%s' failed", Export.Path.Data ? Export.Path.Data : "");
+            }
+            if (!ReadOnly)
+            {
+                ImGui::Separator();
+                if (ImGui::MenuItem("Undo", "Ctrl+Z", false, CanUndo(mem_data, mem_size)))
+                    Undo(mem_data, mem_size);
+                if (ImGui::MenuItem("Redo", "Ctrl+Y", false, CanRedo(mem_data, mem_size)))
+                    Redo(mem_data, mem_size);
+            }
+            if (HasSelection())
+            {
+                ImGui::Separator();
+                if (!ReadOnly && ImGui::Selectable("Paste hex"))
+                    PasteHex(mem_data, mem_size, ImGui::GetClipboardText());
+                if (!ReadOnly && ImGui::Selectable("Fill/Transform..."))
+                    OpenTransform();
+                if (!ReadOnly && IsResizable() && ImGui::Selectable("Insert hex"))
+                    InsertHex(ImGui::GetClipboardText());
+                if (!ReadOnly && IsResizable() && ImGui::Selectable("Delete bytes"))
+                    EraseSelection();
+                for (int n = 0; n < TextFormat_Raw; n++)
+                {
+                    char label[32];
+                    ImSnprintf(label, IM_ARRAYSIZE(label), "Copy as %s", TextFormatGetDesc((TextFormat)n));
+                    if (ImGui::Selectable(label))
+                        CopySelection(mem_data, (TextFormat)n, s.AddrDigitsCount, base_display_addr);
+                }
+            }
+            if (MemoryBudget)
+            {
+                // Memory stats
+                const float mb = 1.0f / (1024.0f * 1024.0f);
+                ImGui::Separator();
+                if (MemoryBudget->Budget > 0)
+                    ImGui::Text("Memory: %.1f / %.1f MB%s", MemoryBudget->GetUsage() * mb, MemoryBudget->Budget * mb, MemoryBudget->OverBudget ? " (over budget)" : "");
+                else
+                    ImGui::Text("Memory: %.1f MB", MemoryBudget->GetUsage() * mb);
+                ImGui::Text("Peak: %.1f MB, evicted: %.1f MB", MemoryBudget->PeakUsage * mb, MemoryBudget->EvictedBytes * mb);
+                const MemoryEditorMemoryBudget::Consumer* consumers[] = { &GetShared().CacheConsumer, &GetShared().JournalConsumer, &RowPrep.Consumer, &Search.BufferConsumer, &FrameArenaConsumer };
+                for (const MemoryEditorMemoryBudget::Consumer* consumer : consumers)
+                    ImGui::Text("  %s: %.1f MB", consumer->Name, consumer->Usage * mb);
+            }
 
             ImGui::EndPopup();
         }
     }
 
+    void DrawTransformLine(const Sizes& s, void* mem_data)
+    {
+        ImGuiStyle& style = ImGui::GetStyle();
+        ImGui::PushID("transform");
+        ImGui::AlignTextToFramePadding();
+        ImGui::Text("%s %" _PRISizeT "u bytes", PendingTransform.Op == TransformOp_Fill ? "Fill" : "Transform", GetSelectionMax() - GetSelectionMin());
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(s.GlyphWidth * 12.0f + style.FramePadding.x * 2.0f + style.ItemInnerSpacing.x);
+        if (ImGui::BeginCombo("##op", TransformOpGetDesc(PendingTransform.Op)))
+        {
+            for (int n = 0; n < TransformOp_COUNT; n++)
+                if (ImGui::Selectable(TransformOpGetDesc((TransformOp)n), PendingTransform.Op == n))
+                    PendingTransform.Op = (TransformOp)n;
+            ImGui::EndCombo();
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(s.GlyphWidth * 24.0f + style.FramePadding.x * 2.0f);
+        bool apply = false;
+        if (ImGui::InputText("##key", TransformKeyBuf, IM_ARRAYSIZE(TransformKeyBuf), ImGuiInputTextFlags_EnterReturnsTrue))
+            apply = true;
+        if (ImGui::IsItemEdited())
+            ParseTransformKey();
+        ImGui::SameLine();
+        if (!TransformKeyValid)
+        {
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Key must be 1-%d hex bytes", (int)Transform::KeyMaxSize);
+            ImGui::SameLine();
+        }
+        if (ImGui::Button("Apply"))
+            apply = true;
+        ImGui::SameLine();
+        if (ImGui::Button("Cancel") || (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && ImGui::IsKeyPressed(ImGuiKey_Escape, false)))
+            CancelTransform();
+        if (apply && TransformKeyValid)
+            ApplyPendingTransform((ImU8*)mem_data);
+        ImGui::PopID();
+    }
+
     void DrawOptionsLine(const Sizes& s, void* mem_data, size_t mem_size, size_t base_display_addr)
     {
-        IM_UNUSED(mem_data);
         ImGuiStyle& style = ImGui::GetStyle();
         const char* format_range = OptUpperCaseHex ? "Range %0*" _PRISizeT "X..%0*" _PRISizeT "X" : "Range %0*" _PRISizeT "x..%0*" _PRISizeT "x";
 
@@ -483,8 +6264,15 @@ struct MemoryEditor
         if (ImGui::Button("Options"))
             ImGui::OpenPopup("OptionsPopup");
 
+        if (GetShared().Regions.Size > 0 || RefreshRate > 0.0f)
+        {
+            ImGui::SameLine();
+            if (ImGui::Button("Refresh"))
+                Refresh();
+        }
+
         ImGui::SameLine();
-        ImGui::Text(format_range, s.AddrDigitsCount, base_display_addr, s.AddrDigitsCount, base_display_addr + mem_size - 1);
+        ImGui::Text(format_range, s.AddrDigitsCount, base_display_addr + GetDisplayAddr(0), s.AddrDigitsCount, base_display_addr + GetDisplayAddr(mem_size - 1));
         ImGui::SameLine();
         ImGui::SetNextItemWidth((s.AddrDigitsCount + 1) * s.GlyphWidth + style.FramePadding.x * 2.0f);
         if (ImGui::InputText("##addr", AddrInputBuf, IM_ARRAYSIZE(AddrInputBuf), ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_EnterReturnsTrue))
@@ -492,11 +6280,77 @@ struct MemoryEditor
             size_t goto_addr;
             if (sscanf(AddrInputBuf, "%" _PRISizeT "X", &goto_addr) == 1)
             {
-                GotoAddr = goto_addr - base_display_addr;
+                GotoAddr = FindDisplayAddr(goto_addr - base_display_addr);
                 HighlightMin = HighlightMax = (size_t)-1;
             }
         }
 
+        // Find: hex pattern, spaces allowed. Enter searches next occurrence after the current one.
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(s.GlyphWidth * 16 + style.FramePadding.x * 2.0f);
+        if (ImGui::InputTextWithHint("##find", "Find hex", FindInputBuf, IM_ARRAYSIZE(FindInputBuf), ImGuiInputTextFlags_EnterReturnsTrue))
+        {
+            ImU8 pattern[IM_ARRAYSIZE(FindInputBuf) / 2];
+            size_t pattern_size = 0;
+            int nibble_count = 0;
+            for (const char* p = FindInputBuf; *p; p++)
+            {
+                const int c = *p;
+                const int nibble = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+                if (nibble < 0)
+                    continue;
+                if ((nibble_count++ & 1) == 0)
+                    pattern[pattern_size++] = (ImU8)(nibble << 4);
+                else
+                    pattern[pattern_size - 1] |= (ImU8)nibble;
+            }
+            const size_t start_addr = (HighlightMin != (size_t)-1) ? HighlightMin + 1 : (DataPreviewAddr != (size_t)-1) ? DataPreviewAddr : 0;
+            if (pattern_size > 0)
+                StartSearch(mem_data, mem_size, start_addr, pattern, pattern_size);
+        }
+        if (Search.Job.IsBusy())
+        {
+            ImGui::SameLine();
+            ImGui::ProgressBar(Search.Job.GetProgress(), ImVec2(s.GlyphWidth * 10, 0.0f));
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Cancel"))
+                CancelJob(&Search.Job);
+        }
+        if (Copy.Job.IsBusy())
+        {
+            ImGui::SameLine();
+            ImGui::Text("Copying");
+            ImGui::SameLine();
+            ImGui::ProgressBar(Copy.Job.GetProgress(), ImVec2(s.GlyphWidth * 10, 0.0f));
+            ImGui::SameLine();
+            ImGui::PushID("copy");
+            if (ImGui::SmallButton("Cancel"))
+                CancelJob(&Copy.Job);
+            ImGui::PopID();
+        }
+        else if (Export.Job.IsBusy())
+        {
+            ImGui::SameLine();
+            ImGui::Text("Exporting");
+            ImGui::SameLine();
+            ImGui::ProgressBar(Export.Job.GetProgress(), ImVec2(s.GlyphWidth * 10, 0.0f));
+            ImGui::SameLine();
+            ImGui::PushID("export");
+            if (ImGui::SmallButton("Cancel"))
+                CancelJob(&Export.Job);
+            ImGui::PopID();
+        }
+        else if (HasSelection() && SelectionAnchorAddr != SelectionCursorAddr)
+        {
+            ImGui::SameLine();
+            ImGui::Text("%" _PRISizeT "u bytes selected", GetSelectionMax() - GetSelectionMin());
+        }
+        if (PasteErrorOffset != (size_t)-1)
+        {
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Invalid hex at offset %" _PRISizeT "u", PasteErrorOffset);
+        }
+
         if (GotoAddr != (size_t)-1)
         {
             if (GotoAddr < mem_size)
@@ -504,7 +6358,7 @@ struct MemoryEditor
                 ImGui::BeginChild("##scrolling");
                 ImGui::SetScrollFromPosY(ImGui::GetCursorStartPos().y + (GotoAddr / Cols) * ImGui::GetTextLineHeight());
                 ImGui::EndChild();
-                DataEditingAddr = DataPreviewAddr = GotoAddr;
+                DataEditingAddr = DataPreviewAddr = SelectionAnchorAddr = SelectionCursorAddr = GotoAddr;
                 DataEditingTakeFocus = true;
             }
             GotoAddr = (size_t)-1;
@@ -546,200 +6400,30 @@ struct MemoryEditor
         ImGui::Text("Bin"); ImGui::SameLine(x); ImGui::TextUnformatted(has_value ? buf : "N/A");
     }
 
-    // Utilities for Data Preview
-    const char* DataTypeGetDesc(ImGuiDataType data_type) const
-    {
-        const char* descs[] = { "Int8", "Uint8", "Int16", "Uint16", "Int32", "Uint32", "Int64", "Uint64", "Float", "Double" };
-        IM_ASSERT(data_type >= 0 && data_type < ImGuiDataType_COUNT);
-        return descs[data_type];
-    }
-
-    size_t DataTypeGetSize(ImGuiDataType data_type) const
-    {
-        const size_t sizes[] = { 1, 1, 2, 2, 4, 4, 8, 8, sizeof(float), sizeof(double) };
-        IM_ASSERT(data_type >= 0 && data_type < ImGuiDataType_COUNT);
-        return sizes[data_type];
-    }
-
-    const char* DataFormatGetDesc(DataFormat data_format) const
-    {
-        const char* descs[] = { "Bin", "Dec", "Hex" };
-        IM_ASSERT(data_format >= 0 && data_format < DataFormat_COUNT);
-        return descs[data_format];
-    }
-
-    bool IsBigEndian() const
-    {
-        uint16_t x = 1;
-        char c[2];
-        memcpy(c, &x, 2);
-        return c[0] != 0;
-    }
-
-    static void* EndiannessCopyBigEndian(void* _dst, void* _src, size_t s, int is_little_endian)
-    {
-        if (is_little_endian)
-        {
-            uint8_t* dst = (uint8_t*)_dst;
-            uint8_t* src = (uint8_t*)_src + s - 1;
-            for (int i = 0, n = (int)s; i < n; ++i)
-                memcpy(dst++, src--, 1);
-            return _dst;
-        }
-        else
-        {
-            return memcpy(_dst, _src, s);
-        }
-    }
-
-    static void* EndiannessCopyLittleEndian(void* _dst, void* _src, size_t s, int is_little_endian)
-    {
-        if (is_little_endian)
-        {
-            return memcpy(_dst, _src, s);
-        }
-        else
-        {
-            uint8_t* dst = (uint8_t*)_dst;
-            uint8_t* src = (uint8_t*)_src + s - 1;
-            for (int i = 0, n = (int)s; i < n; ++i)
-                memcpy(dst++, src--, 1);
-            return _dst;
-        }
-    }
-
-    void* EndiannessCopy(void* dst, void* src, size_t size) const
-    {
-        static void* (*fp)(void*, void*, size_t, int) = NULL;
-        if (fp == NULL)
-            fp = IsBigEndian() ? EndiannessCopyBigEndian : EndiannessCopyLittleEndian;
-        return fp(dst, src, size, PreviewEndianness);
-    }
-
-    const char* FormatBinary(const uint8_t* buf, int width) const
-    {
-        IM_ASSERT(width <= 64);
-        size_t out_n = 0;
-        static char out_buf[64 + 8 + 1];
-        int n = width / 8;
-        for (int j = n - 1; j >= 0; --j)
-        {
-            for (int i = 0; i < 8; ++i)
-                out_buf[out_n++] = (buf[j] & (1 << (7 - i))) ? '1' : '0';
-            out_buf[out_n++] = ' ';
-        }
-        IM_ASSERT(out_n < IM_ARRAYSIZE(out_buf));
-        out_buf[out_n] = 0;
-        return out_buf;
-    }
-
     // [Internal]
-    void DrawPreviewData(size_t addr, const ImU8* mem_data, size_t mem_size, ImGuiDataType data_type, DataFormat data_format, char* out_buf, size_t out_buf_size) const
+    void DrawPreviewData(size_t addr, const ImU8* mem_data, size_t mem_size, ImGuiDataType data_type, DataFormat data_format, char* out_buf, size_t out_buf_size)
     {
         uint8_t buf[8];
+        uint8_t buf_state[8];
         size_t elem_size = DataTypeGetSize(data_type);
         size_t size = addr + elem_size > mem_size ? mem_size - addr : elem_size;
-        if (ReadFn)
-            for (int i = 0, n = (int)size; i < n; ++i)
-                buf[i] = ReadFn(mem_data, addr + i);
-        else
-            memcpy(buf, mem_data + addr, size);
-
-        if (data_format == DataFormat_Bin)
-        {
-            uint8_t binbuf[8];
-            EndiannessCopy(binbuf, buf, size);
-            ImSnprintf(out_buf, out_buf_size, "%s", FormatBinary(binbuf, (int)size * 8));
-            return;
-        }
-
-        out_buf[0] = 0;
-        switch (data_type)
-        {
-        case ImGuiDataType_S8:
-        {
-            int8_t data = 0;
-            EndiannessCopy(&data, buf, size);
-            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%hhd", data); return; }
-            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%02x", data & 0xFF); return; }
-            break;
-        }
-        case ImGuiDataType_U8:
-        {
-            uint8_t data = 0;
-            EndiannessCopy(&data, buf, size);
-            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%hhu", data); return; }
-            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%02x", data & 0XFF); return; }
-            break;
-        }
-        case ImGuiDataType_S16:
-        {
-            int16_t data = 0;
-            EndiannessCopy(&data, buf, size);
-            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%hd", data); return; }
-            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%04x", data & 0xFFFF); return; }
-            break;
-        }
-        case ImGuiDataType_U16:
-        {
-            uint16_t data = 0;
-            EndiannessCopy(&data, buf, size);
-            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%hu", data); return; }
-            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%04x", data & 0xFFFF); return; }
-            break;
-        }
-        case ImGuiDataType_S32:
-        {
-            int32_t data = 0;
-            EndiannessCopy(&data, buf, size);
-            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%d", data); return; }
-            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%08x", data); return; }
-            break;
-        }
-        case ImGuiDataType_U32:
-        {
-            uint32_t data = 0;
-            EndiannessCopy(&data, buf, size);
-            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%u", data); return; }
-            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%08x", data); return; }
-            break;
-        }
-        case ImGuiDataType_S64:
-        {
-            int64_t data = 0;
-            EndiannessCopy(&data, buf, size);
-            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%lld", (long long)data); return; }
-            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%016llx", (long long)data); return; }
-            break;
-        }
-        case ImGuiDataType_U64:
-        {
-            uint64_t data = 0;
-            EndiannessCopy(&data, buf, size);
-            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%llu", (long long)data); return; }
-            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "0x%016llx", (long long)data); return; }
-            break;
-        }
-        case ImGuiDataType_Float:
+        if (addr == SnapshotPreviewAddr)
         {
-            float data = 0.0f;
-            EndiannessCopy(&data, buf, size);
-            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%f", data); return; }
-            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "%a", data); return; }
-            break;
+            memcpy(buf, SnapshotPreviewData, size);
+            memcpy(buf_state, SnapshotPreviewState, size);
         }
-        case ImGuiDataType_Double:
+        else
         {
-            double data = 0.0;
-            EndiannessCopy(&data, buf, size);
-            if (data_format == DataFormat_Dec) { ImSnprintf(out_buf, out_buf_size, "%f", data); return; }
-            if (data_format == DataFormat_Hex) { ImSnprintf(out_buf, out_buf_size, "%a", data); return; }
-            break;
+            ReadRange(mem_data, addr, buf, buf_state, size);
+            PreviewTransform(addr, buf, size);
         }
-        case ImGuiDataType_COUNT:
-            break;
-        } // Switch
-        IM_ASSERT(0); // Shouldn't reach
+        for (size_t i = 0; i < size; i++)
+            if (buf_state[i] != ByteState_Valid)
+            {
+                ImSnprintf(out_buf, out_buf_size, (buf_state[i] == ByteState_Unreadable) ? "??" : "--");
+                return;
+            }
+        FormatData(buf, size, data_type, data_format, PreviewEndianness, out_buf, out_buf_size);
     }
 };
 
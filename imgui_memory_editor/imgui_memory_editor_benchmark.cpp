@@ -0,0 +1,144 @@
+// Allocation benchmark for imgui_memory_editor.h
+// Runs scenarios (idle, scrolling, editing, highlighting, changing data) with a headless Dear ImGui context, and fails when
+// DrawContents() allocates once warmed up (MemoryEditor::AllocCheckWarmupFrames). Prints allocation counters of each scenario.
+//
+// Build (no backend needed), from a directory containing the Dear ImGui sources:
+//   c++ -std=c++11 -O2 -I. -I$IMGUI_CLUB/imgui_memory_editor $IMGUI_CLUB/imgui_memory_editor/imgui_memory_editor_benchmark.cpp imgui*.cpp -lpthread -o imgui_memory_editor_benchmark
+// Run:
+//   ./imgui_memory_editor_benchmark [frames]      // exit code is non-zero if a scenario failed
+
+#include "imgui.h"
+#include "imgui_memory_editor.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+enum Scenario_
+{
+    Scenario_Idle,
+    Scenario_Scrolling,
+    Scenario_Editing,
+    Scenario_Highlighting,
+    Scenario_ChangingData,
+    Scenario_COUNT
+};
+
+static const char* ScenarioNames[Scenario_COUNT] = { "idle", "scrolling", "editing", "highlighting", "changing data" };
+
+static bool HighlightEveryFourthByte(const ImU8*, size_t off) { return (off & 3) == 0; }
+
+static void NewFrame()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280.0f, 720.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.AddMousePosEvent(400.0f, 300.0f);    // over the editor, so wheel events scroll it
+    ImGui::NewFrame();
+}
+
+static bool RunScenario(int scenario, ImU8* data, size_t data_size, int frames, int warmup_frames, bool use_jobs)
+{
+    printf("%-14s%s: ", ScenarioNames[scenario], use_jobs ? " (jobs)" : "       ");
+    fflush(stdout); // the allocation check asserts: make it clear which scenario failed
+
+#ifndef IMGUI_MEMORY_EDITOR_NO_THREADS
+    MemoryEditorJobSystem job_system;
+    if (use_jobs)
+        job_system.Start(2);
+#endif
+    MemoryEditor::SharedState shared;
+    MemoryEditor mem_edit;
+    mem_edit.Shared = &shared;
+    mem_edit.AllocCheckWarmupFrames = warmup_frames;
+#ifndef IMGUI_MEMORY_EDITOR_NO_THREADS
+    if (use_jobs)
+        mem_edit.JobSystem = &job_system;
+#endif
+    if (scenario == Scenario_Highlighting)
+    {
+        mem_edit.HighlightFn = HighlightEveryFourthByte;
+        shared.AddHighlight(0x100, 0x2000, IM_COL32(255, 0, 0, 60));
+        shared.AddHighlight(0x1800, 0x1900, IM_COL32(0, 255, 0, 60));
+    }
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        NewFrame();
+        ImGuiIO& io = ImGui::GetIO();
+        switch (scenario)
+        {
+        case Scenario_Scrolling:
+            // Scroll down for a while, then back up, so rows are both predicted ahead and revisited
+            io.AddMouseWheelEvent(0.0f, ((frame / 50) & 1) ? 3.0f : -3.0f);
+            break;
+        case Scenario_Editing:
+            // Move the edited byte around and write to it
+            if ((frame % 4) == 0)
+            {
+                mem_edit.GotoAddrAndHighlight((size_t)(frame * 17) % 0x4000, (size_t)(frame * 17) % 0x4000 + 1);
+                mem_edit.DataEditingAddr = mem_edit.DataPreviewAddr = (size_t)(frame * 17) % 0x4000;
+                mem_edit.DataEditingTakeFocus = true;
+            }
+            io.AddInputCharacter("0123456789ABCDEF"[frame & 15]);
+            break;
+        case Scenario_Highlighting:
+            mem_edit.SetSelection((size_t)frame % 0x200, (size_t)frame % 0x200 + 0x40);
+            mem_edit.GotoAddrAndHighlight(0x40 + (size_t)(frame % 16), 0x80);
+            break;
+        case Scenario_ChangingData:
+            for (size_t n = 0; n < 0x1000; n++)
+                data[(n * 13 + (size_t)frame) % data_size] ^= (ImU8)frame;
+            break;
+        }
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(ImVec2(800.0f, 600.0f));
+        mem_edit.DrawWindow("Memory Editor", data, data_size);
+        ImGui::Render();
+        if (mem_edit.AllocStats.CheckFailed)
+            break;
+    }
+
+    const MemoryEditorAllocStats& stats = mem_edit.AllocStats;
+    printf("%s, %d allocations (%d frees), %d KB high-water mark, last frame: %d allocations\n",
+        stats.CheckFailed ? "FAILED" : "ok", stats.AllocCount.load(), stats.FreeCount.load(), (int)(stats.HighWaterBytes.load() / 1024), stats.FrameAllocCount);
+    return !stats.CheckFailed;
+}
+
+int main(int argc, char** argv)
+{
+    const int frames = (argc > 1) ? atoi(argv[1]) : 300;
+    const int warmup_frames = 10;
+
+    MemoryEditorAllocStats::InstallImGuiHooks();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+#if IMGUI_VERSION_NUM >= 19200
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+#else
+    unsigned char* tex_pixels;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+#endif
+
+    const size_t data_size = 4 * 1024 * 1024;
+    ImU8* data = (ImU8*)malloc(data_size);
+    for (size_t n = 0; n < data_size; n++)
+        data[n] = (ImU8)(n * 7 + (n >> 8));
+
+    int failed_count = 0;
+    for (int use_jobs = 0; use_jobs < 2; use_jobs++)
+    {
+#ifdef IMGUI_MEMORY_EDITOR_NO_THREADS
+        if (use_jobs)
+            break;
+#endif
+        for (int scenario = 0; scenario < Scenario_COUNT; scenario++)
+            if (!RunScenario(scenario, data, data_size, frames, warmup_frames, use_jobs != 0))
+                failed_count++;
+    }
+
+    free(data);
+    ImGui::DestroyContext();
+    printf("%s\n", failed_count ? "FAILED" : "all scenarios passed");
+    return failed_count ? 1 : 0;
+}